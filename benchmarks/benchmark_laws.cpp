@@ -0,0 +1,141 @@
+#include <benchmark/benchmark.h>
+#include "interfaces.h"
+#include "linear_elastic.h"
+#include "local_damage.h"
+
+/*
+ * Microbenchmarks for the per-IP evaluate cost of the laws and the IpLoop
+ * dispatch. Run e.g. with
+ *
+ *     ./benchmark_laws --benchmark_format=json
+ *
+ * to track IPs/second across commits. `items_per_second` is IPs/second,
+ * `bytes_per_second` refers to the written SIGMA + DSIGMA_DEPS bytes.
+ */
+
+namespace
+{
+Eigen::VectorXd RandomStrains(int n, int q)
+{
+    return Eigen::VectorXd::Random(n * q) * 1.e-3;
+}
+
+void Report(benchmark::State& state, int n, int q)
+{
+    state.SetItemsProcessed(state.iterations() * n);
+    state.SetBytesProcessed(state.iterations() * n * (q + q * q) * sizeof(double));
+}
+} // namespace
+
+template <Constraint TC>
+static void LinearElasticDynamic(benchmark::State& state)
+{
+    const int n = state.range(0);
+    IpLoop loop;
+    loop.AddLaw(std::make_shared<LinearElastic>(20000., 0.2, TC), {});
+    loop.Resize(n);
+    const Eigen::VectorXd eps = RandomStrains(n, Dim::Q(TC));
+
+    for (auto _ : state)
+        loop.Evaluate(eps, Eigen::VectorXd());
+    Report(state, n, Dim::Q(TC));
+}
+
+template <Constraint TC>
+static void LinearElasticFixed(benchmark::State& state)
+{
+    const int n = state.range(0);
+    IpLoop loop;
+    loop.AddLaw(std::static_pointer_cast<LawInterface>(std::make_shared<LinearElasticT<TC>>(20000., 0.2)), {});
+    loop.Resize(n);
+    const Eigen::VectorXd eps = RandomStrains(n, Dim::Q(TC));
+
+    for (auto _ : state)
+        loop.Evaluate(eps, Eigen::VectorXd());
+    Report(state, n, Dim::Q(TC));
+}
+
+template <Constraint TC>
+static void LocalDamageDynamic(benchmark::State& state)
+{
+    const int n = state.range(0);
+    auto omega = std::make_shared<DamageLawExponential>(1.e-4, 0.99, 200.);
+    auto norm = std::make_shared<ModMisesEeq>(10., 0.2, TC);
+    IpLoop loop;
+    loop.AddLaw(std::make_shared<LocalDamage>(20000., 0.2, TC, omega, norm), {});
+    loop.Resize(n);
+    const Eigen::VectorXd eps = RandomStrains(n, Dim::Q(TC));
+
+    for (auto _ : state)
+        loop.Evaluate(eps, Eigen::VectorXd());
+    Report(state, n, Dim::Q(TC));
+}
+
+template <Constraint TC>
+static void GradientDamageDynamic(benchmark::State& state)
+{
+    const int n = state.range(0);
+    auto omega = std::make_shared<DamageLawExponential>(1.e-4, 0.99, 200.);
+    auto norm = std::make_shared<ModMisesEeq>(10., 0.2, TC);
+    IpLoop loop;
+    loop.AddLaw(std::static_pointer_cast<LawInterface>(std::make_shared<GradientDamage>(20000., 0.2, TC, omega, norm)),
+                {});
+    loop.Resize(n);
+    const Eigen::VectorXd eps = RandomStrains(n, Dim::Q(TC));
+    const Eigen::VectorXd neeq = Eigen::VectorXd::Random(n).cwiseAbs() * 1.e-3;
+
+    for (auto _ : state)
+        loop.Evaluate(eps, neeq);
+    Report(state, n, Dim::Q(TC));
+}
+
+template <Constraint TC>
+static void GradientDamageFixed(benchmark::State& state)
+{
+    const int n = state.range(0);
+    auto omega = std::make_shared<DamageLawExponential>(1.e-4, 0.99, 200.);
+    auto norm = std::make_shared<ModMisesEeq>(10., 0.2, TC);
+    IpLoop loop;
+    loop.AddLaw(
+            std::static_pointer_cast<LawInterface>(std::make_shared<GradientDamageT<TC>>(20000., 0.2, omega, norm)),
+            {});
+    loop.Resize(n);
+    const Eigen::VectorXd eps = RandomStrains(n, Dim::Q(TC));
+    const Eigen::VectorXd neeq = Eigen::VectorXd::Random(n).cwiseAbs() * 1.e-3;
+
+    for (auto _ : state)
+        loop.Evaluate(eps, neeq);
+    Report(state, n, Dim::Q(TC));
+}
+
+template <Constraint TC>
+static void ModMises(benchmark::State& state)
+{
+    const int n = state.range(0);
+    constexpr int q = Dim::Q(TC);
+    const ModMisesEeq norm(10., 0.2, TC);
+    const Eigen::VectorXd eps = RandomStrains(n, q);
+
+    for (auto _ : state)
+        for (int ip = 0; ip < n; ++ip)
+            benchmark::DoNotOptimize(norm.Evaluate(eps.segment<q>(q * ip)));
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+#define CONSTITUTIVE_BENCHMARK(BM, TC) BENCHMARK_TEMPLATE(BM, TC)->RangeMultiplier(10)->Range(1000, 1000000)
+
+#define CONSTITUTIVE_BENCHMARK_ALL(BM)                                                                                 \
+    CONSTITUTIVE_BENCHMARK(BM, UNIAXIAL_STRAIN);                                                                       \
+    CONSTITUTIVE_BENCHMARK(BM, UNIAXIAL_STRESS);                                                                       \
+    CONSTITUTIVE_BENCHMARK(BM, PLANE_STRAIN);                                                                          \
+    CONSTITUTIVE_BENCHMARK(BM, PLANE_STRESS);                                                                          \
+    CONSTITUTIVE_BENCHMARK(BM, FULL)
+
+CONSTITUTIVE_BENCHMARK_ALL(LinearElasticDynamic);
+CONSTITUTIVE_BENCHMARK_ALL(LinearElasticFixed);
+CONSTITUTIVE_BENCHMARK_ALL(LocalDamageDynamic);
+CONSTITUTIVE_BENCHMARK_ALL(GradientDamageDynamic);
+CONSTITUTIVE_BENCHMARK_ALL(GradientDamageFixed);
+CONSTITUTIVE_BENCHMARK_ALL(ModMises);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,32 @@
+"""
+Thin entry for the C++ BendingBenchmark: runs the gradient-damage
+three-point-bending problem at a parameterizable mesh scale and prints the
+per-phase time breakdown as JSON, e.g.
+
+    python3 bending_benchmark.py --nx 2500 --ny 250 --steps 10 --threads 8
+
+gives 2.5e6 IPs. Track the "seconds/..." entries across commits to guard
+the per-phase budget.
+"""
+import argparse
+import json
+
+from constitutive.cpp import BendingBenchmark
+
+
+def main():
+    p = argparse.ArgumentParser(description=__doc__)
+    p.add_argument("--nx", type=int, default=500, help="elements along the span")
+    p.add_argument("--ny", type=int, default=50, help="elements over the height")
+    p.add_argument("--steps", type=int, default=10, help="number of load steps")
+    p.add_argument("--u-max", type=float, default=0.5, help="final midspan deflection")
+    p.add_argument("--threads", type=int, default=1)
+    args = p.parse_args()
+
+    bench = BendingBenchmark(args.nx, args.ny, args.threads)
+    result = bench.run(args.steps, args.u_max)
+    print(json.dumps(result, indent=2, sort_keys=True))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,137 @@
+#pragma once
+#include "interfaces.h"
+
+//! @brief fused assembly of the residual/tangent quadrature contributions
+//!
+//! Replaces the stress round trip through the quadrature function spaces --
+//! two full-array copies plus an FFC assembly per iteration -- by one pass
+//! over the cells that turns `IpLoop` outputs directly into per-cell
+//! internal forces B^T sigma w and stiffness blocks B^T C B w. The residual
+//! is scattered into a global vector, the stiffness into the cell-major COO
+//! value block of `CooIndices`, both PETSc/scipy-compatible. Each cell's
+//! stresses stay in cache instead of being written to an intermediate field.
+class AssemblyKernel
+{
+public:
+    //! @param dofmap n_cells x dofs_per_cell global indices into the
+    //!               displacement vector
+    //! @param b stacked B-matrices, laid out as in `StrainKernel`
+    //! @param weights quadrature weight times detJ, one entry per IP
+    //! @param q number of strain/stress components per IP
+    AssemblyKernel(Eigen::MatrixXi dofmap, Eigen::MatrixXd b, Eigen::VectorXd weights, int q)
+        : _dofmap(std::move(dofmap))
+        , _b(std::move(b))
+        , _weights(std::move(weights))
+        , _q(q)
+    {
+        if (_b.cols() != _dofmap.cols())
+            throw std::runtime_error("The B-matrix columns don't match the dofs per cell!");
+        if (_dofmap.rows() == 0 or _b.rows() % (_q * _dofmap.rows()) != 0)
+            throw std::runtime_error("The B-matrix rows are no multiple of q times the number of cells!");
+        _ips_per_cell = _b.rows() / _q / _dofmap.rows();
+        if (_weights.size() != NumIps())
+            throw std::runtime_error("One quadrature weight per IP required!");
+    }
+
+    int NumIps() const
+    {
+        return _dofmap.rows() * _ips_per_cell;
+    }
+
+    int NumCells() const
+    {
+        return _dofmap.rows();
+    }
+
+    //! @brief global row/column indices of the cell-major stiffness values
+    //! written by `AssembleInto`, computed once for the sparsity setup
+    std::pair<Eigen::VectorXi, Eigen::VectorXi> CooIndices() const
+    {
+        const int n_dofs = _dofmap.cols();
+        Eigen::VectorXi rows(NumCells() * n_dofs * n_dofs);
+        Eigen::VectorXi cols(rows.size());
+        for (int cell = 0; cell < NumCells(); ++cell)
+            for (int i = 0; i < n_dofs; ++i)
+                for (int j = 0; j < n_dofs; ++j)
+                {
+                    const int entry = (cell * n_dofs + i) * n_dofs + j;
+                    rows[entry] = _dofmap(cell, i);
+                    cols[entry] = _dofmap(cell, j);
+                }
+        return {rows, cols};
+    }
+
+    //! @brief one fused pass turning per-IP SIGMA / DSIGMA_DEPS into the
+    //! global residual and the COO stiffness values
+    //!
+    //! Expects the plain, expanded double storage layout in global IP order.
+    void AssembleInto(Eigen::Ref<const Eigen::VectorXd> sigma, Eigen::Ref<const Eigen::VectorXd> dsigma,
+                      Eigen::Ref<Eigen::VectorXd> residual, Eigen::Ref<Eigen::VectorXd> k_values,
+                      int threads = 1) const
+    {
+        if (sigma.size() != NumIps() * _q or dsigma.size() != NumIps() * _q * _q)
+            throw std::runtime_error("The SIGMA/DSIGMA_DEPS sizes don't match the number of IPs!");
+        const int n_dofs = _dofmap.cols();
+        if (k_values.size() != NumCells() * n_dofs * n_dofs)
+            throw std::runtime_error("The stiffness buffer size doesn't match the COO layout!");
+
+        residual.setZero();
+#ifdef _OPENMP
+#pragma omp parallel num_threads(threads) if (threads > 1)
+#endif
+        {
+            Eigen::VectorXd f_cell(n_dofs);
+            Eigen::MatrixXd k_cell(n_dofs, n_dofs);
+#ifdef _OPENMP
+#pragma omp for schedule(static)
+#endif
+            for (int cell = 0; cell < NumCells(); ++cell)
+            {
+                f_cell.setZero();
+                k_cell.setZero();
+                for (int ip_cell = 0; ip_cell < _ips_per_cell; ++ip_cell)
+                {
+                    const int ip = cell * _ips_per_cell + ip_cell;
+                    const double w = _weights[ip];
+                    const auto b_ip = _b.middleRows(ip * _q, _q);
+                    Eigen::Map<const Eigen::MatrixXd> C(dsigma.data() + ip * _q * _q, _q, _q);
+                    f_cell.noalias() += b_ip.transpose() * (w * sigma.segment(ip * _q, _q));
+                    k_cell.noalias() += b_ip.transpose() * (w * C) * b_ip;
+                }
+                // row-major to match the (row, col) ordering of CooIndices
+                Eigen::Map<Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>>(
+                        k_values.data() + cell * n_dofs * n_dofs, n_dofs, n_dofs) = k_cell;
+                for (int dof = 0; dof < n_dofs; ++dof)
+                {
+                    const int row = _dofmap(cell, dof);
+                    // cells share dofs, so the scatter needs the atomic
+#ifdef _OPENMP
+#pragma omp atomic
+#endif
+                    residual[row] += f_cell[dof];
+                }
+            }
+        }
+    }
+
+    //! @brief like above, but reads SIGMA / DSIGMA_DEPS straight from the
+    //! loop's storage without the `Get` copies
+    void AssembleInto(const IpLoop& loop, Eigen::Ref<Eigen::VectorXd> residual, Eigen::Ref<Eigen::VectorXd> k_values,
+                      int threads = 1) const
+    {
+        loop.Wait(); // a pending EvaluateAsync sweep still writes _outputs
+        const QValues& sig = loop._outputs[SIGMA];
+        const QValues& dsig = loop._outputs[DSIGMA_DEPS];
+        if (sig.IsSymmetric() or sig.IsSinglePrecision() or dsig.IsSymmetric() or dsig.IsSinglePrecision() or
+            loop.IsGrouped())
+            throw std::runtime_error("Fused assembly requires plain storage in global IP order, use Get instead!");
+        AssembleInto(sig.data, dsig.data, residual, k_values, threads);
+    }
+
+private:
+    const Eigen::MatrixXi _dofmap;
+    const Eigen::MatrixXd _b;
+    const Eigen::VectorXd _weights;
+    const int _q;
+    int _ips_per_cell;
+};
@@ -0,0 +1,283 @@
+#pragma once
+#include "assembly_kernel.h"
+#include "local_damage.h"
+#include "strain_kernel.h"
+#include <eigen3/Eigen/Sparse>
+
+//! @brief end-to-end gradient-damage bending benchmark with a per-phase
+//! time breakdown
+//!
+//! Replicates the three-point-bending problem of
+//! `examples/gradient_damage.py` on a structured quad mesh of `nx` x `ny`
+//! bilinear elements (2x2 Gauss, plane strain), but entirely through the
+//! C++ kernels, so realistic scales (1e5-1e7 IPs) run without the FEniCS
+//! round trips. Every Newton iteration exercises the full stack -- strain
+//! projection (`StrainKernel`), `IpLoop::Evaluate`, fused assembly
+//! (`AssemblyKernel` plus the sparse scatter), the direct solve and the
+//! history `Update` -- and each phase is timed separately. `Run` returns
+//! the machine-readable breakdown to guard the per-phase budget across
+//! commits.
+//!
+//! The nonlocal strain is coupled explicitly: each step evaluates with the
+//! EEQ field of the previous step (staggered), which keeps the per-phase
+//! costs representative without assembling the coupled two-field system.
+class BendingBenchmark
+{
+public:
+    BendingBenchmark(int nx, int ny, int threads = 1)
+        : _nx(nx)
+        , _ny(ny)
+        , _threads(threads)
+    {
+        if (nx < 2 or ny < 1)
+            throw std::runtime_error("The bending mesh needs at least 2 x 1 elements!");
+
+        BuildMesh();
+
+        _strain_kernel.reset(new StrainKernel(_dofmap, _b, q));
+        _assembly_kernel.reset(new AssemblyKernel(_dofmap, _b, _weights, q));
+
+        _gdm = std::make_shared<GradientDamage>(_E, _nu, PLANE_STRAIN,
+                                                std::make_shared<DamageLawExponential>(_k0, _alpha, _beta),
+                                                std::make_shared<ModMisesEeq>(_k, _nu, PLANE_STRAIN));
+        _loop.AddLaw(std::static_pointer_cast<LawInterface>(_gdm), {});
+        _loop.Resize(NumIps());
+
+        _u.setZero(NumDofs());
+        _ebar.setZero(NumIps());
+        _eps.setZero(NumIps() * q);
+        _residual.setZero(NumDofs());
+        _k_values.setZero(static_cast<long>(NumCells()) * dofs_per_cell * dofs_per_cell);
+
+        BuildSparsity();
+    }
+
+    int NumIps() const
+    {
+        return NumCells() * ips_per_cell;
+    }
+
+    int NumCells() const
+    {
+        return _nx * _ny;
+    }
+
+    int NumDofs() const
+    {
+        return 2 * (_nx + 1) * (_ny + 1);
+    }
+
+    //! @brief runs `steps` displacement-controlled load steps up to the
+    //! midspan deflection `u_max` and returns the phase breakdown:
+    //! "seconds/<phase>" plus the problem counters, all as doubles
+    std::map<std::string, double> Run(int steps, double u_max)
+    {
+        const auto t_total = Clock::now();
+        for (int step = 1; step <= steps; ++step)
+        {
+            const double target = -u_max * step / steps;
+            LoadStep(target);
+        }
+        _seconds["total"] += Elapsed(t_total);
+
+        std::map<std::string, double> result;
+        for (const auto& phase : _seconds)
+            result["seconds/" + phase.first] = phase.second;
+        result["n_cells"] = NumCells();
+        result["n_ips"] = NumIps();
+        result["n_dofs"] = NumDofs();
+        result["steps"] = steps;
+        result["newton_iterations"] = _newton_iterations;
+        result["kappa_max"] = _gdm->Kappa().maxCoeff();
+        return result;
+    }
+
+private:
+    using Clock = std::chrono::steady_clock;
+    // plane strain, bilinear quads with 2x2 Gauss
+    enum
+    {
+        q = 3,
+        ips_per_cell = 4,
+        dofs_per_cell = 8
+    };
+
+    static double Elapsed(Clock::time_point since)
+    {
+        return std::chrono::duration<double>(Clock::now() - since).count();
+    }
+
+    //! @brief dofmap, B-matrices and weights of the structured quad mesh;
+    //! span 10:1, supports at the bottom corners, load at the top midspan
+    void BuildMesh()
+    {
+        const double height = 1.;
+        const double dx = 10. * height / _nx;
+        const double dy = height / _ny;
+
+        _dofmap.resize(NumCells(), dofs_per_cell);
+        for (int iy = 0; iy < _ny; ++iy)
+            for (int ix = 0; ix < _nx; ++ix)
+            {
+                const int cell = iy * _nx + ix;
+                const int nodes[4] = {iy * (_nx + 1) + ix, iy * (_nx + 1) + ix + 1, (iy + 1) * (_nx + 1) + ix + 1,
+                                      (iy + 1) * (_nx + 1) + ix};
+                for (int i = 0; i < 4; ++i)
+                {
+                    _dofmap(cell, 2 * i) = 2 * nodes[i];
+                    _dofmap(cell, 2 * i + 1) = 2 * nodes[i] + 1;
+                }
+            }
+
+        // identical rectangular elements: one set of 2x2 Gauss B-matrices,
+        // replicated into the stacked layout the kernels expect
+        const double g = 1. / std::sqrt(3.);
+        const double xi_node[4] = {-1., 1., 1., -1.};
+        const double eta_node[4] = {-1., -1., 1., 1.};
+        Eigen::MatrixXd b_cell(ips_per_cell * q, dofs_per_cell);
+        int ip = 0;
+        for (double eta : {-g, g})
+            for (double xi : {-g, g})
+            {
+                for (int i = 0; i < 4; ++i)
+                {
+                    const double dN_dx = xi_node[i] * (1. + eta_node[i] * eta) / 4. * 2. / dx;
+                    const double dN_dy = eta_node[i] * (1. + xi_node[i] * xi) / 4. * 2. / dy;
+                    b_cell.block<q, 2>(ip * q, 2 * i) << dN_dx, 0., 0., dN_dy, dN_dy, dN_dx;
+                }
+                ++ip;
+            }
+        _b.resize(static_cast<long>(NumCells()) * ips_per_cell * q, dofs_per_cell);
+        for (int cell = 0; cell < NumCells(); ++cell)
+            _b.middleRows(cell * ips_per_cell * q, ips_per_cell * q) = b_cell;
+        _weights = Eigen::VectorXd::Constant(NumIps(), dx * dy / 4.);
+
+        // three-point bending: pinned bottom left, bottom right roller, the
+        // midspan load dof is driven to the step target
+        const int bottom_left = 0;
+        const int bottom_right = _nx;
+        const int top_middle = _ny * (_nx + 1) + _nx / 2;
+        _fixed_dofs = {2 * bottom_left, 2 * bottom_left + 1, 2 * bottom_right + 1};
+        _load_dof = 2 * top_middle + 1;
+    }
+
+    //! @brief assembles the sparsity pattern once and maps every COO entry
+    //! (and the constrained diagonals) to its position in the value array,
+    //! so later assemblies are one O(nnz) scatter without re-sorting
+    void BuildSparsity()
+    {
+        Eigen::VectorXi rows, cols;
+        std::tie(rows, cols) = _assembly_kernel->CooIndices();
+
+        std::vector<Eigen::Triplet<double>> triplets;
+        triplets.reserve(rows.size());
+        for (int entry = 0; entry < rows.size(); ++entry)
+            triplets.emplace_back(rows[entry], cols[entry], 0.);
+        _K.resize(NumDofs(), NumDofs());
+        _K.setFromTriplets(triplets.begin(), triplets.end());
+        _K.makeCompressed();
+
+        _nnz_of_entry.resize(rows.size());
+        for (int entry = 0; entry < rows.size(); ++entry)
+            _nnz_of_entry[entry] = &_K.coeffRef(rows[entry], cols[entry]) - _K.valuePtr();
+        for (int dof : ConstrainedDofs())
+            _nnz_of_diagonal.push_back(&_K.coeffRef(dof, dof) - _K.valuePtr());
+
+        _solver.analyzePattern(_K);
+    }
+
+    std::vector<int> ConstrainedDofs() const
+    {
+        std::vector<int> dofs = _fixed_dofs;
+        dofs.push_back(_load_dof);
+        return dofs;
+    }
+
+    //! @brief one displacement-controlled step: Newton on u with the
+    //! nonlocal strain of the previous step, then the history update
+    void LoadStep(double target)
+    {
+        constexpr int max_newton = 10;
+        const double penalty = 1.e8 * _E;
+
+        for (int iteration = 0;; ++iteration)
+        {
+            auto t = Clock::now();
+            _strain_kernel->ComputeInto(_u, _eps, _threads);
+            _seconds["strain"] += Elapsed(t);
+
+            t = Clock::now();
+            _loop.Evaluate(_eps, _ebar, _threads);
+            _seconds["evaluate"] += Elapsed(t);
+
+            t = Clock::now();
+            _assembly_kernel->AssembleInto(_loop, _residual, _k_values, _threads);
+            std::fill(_K.valuePtr(), _K.valuePtr() + _K.nonZeros(), 0.);
+            for (long entry = 0; entry < _k_values.size(); ++entry)
+                _K.valuePtr()[_nnz_of_entry[entry]] += _k_values[entry];
+            for (long nnz : _nnz_of_diagonal)
+                _K.valuePtr()[nnz] += penalty;
+            for (int dof : _fixed_dofs)
+                _residual[dof] += penalty * _u[dof];
+            _residual[_load_dof] += penalty * (_u[_load_dof] - target);
+            _seconds["assembly"] += Elapsed(t);
+
+            t = Clock::now();
+            _solver.factorize(_K);
+            if (_solver.info() != Eigen::Success)
+                throw std::runtime_error("The stiffness factorization failed!");
+            const Eigen::VectorXd du = _solver.solve(-_residual);
+            _u += du;
+            _seconds["solve"] += Elapsed(t);
+
+            ++_newton_iterations;
+            if (du.norm() <= 1.e-8 * (1. + _u.norm()))
+                break;
+            if (iteration >= max_newton)
+                throw std::runtime_error("The bending step did not converge!");
+        }
+
+        auto t = Clock::now();
+        _strain_kernel->ComputeInto(_u, _eps, _threads);
+        _loop.Update(_eps, _ebar, _threads);
+        _ebar = _loop.Get(EEQ); // the staggered nonlocal field of the next step
+        _seconds["update"] += Elapsed(t);
+    }
+
+    // material of examples/gradient_damage.py
+    const double _E = 20000.;
+    const double _nu = 0.2;
+    const double _k = 10.;
+    const double _k0 = 1.e-4;
+    const double _alpha = 0.99;
+    const double _beta = 100.;
+
+    const int _nx;
+    const int _ny;
+    const int _threads;
+
+    Eigen::MatrixXi _dofmap;
+    Eigen::MatrixXd _b;
+    Eigen::VectorXd _weights;
+    std::vector<int> _fixed_dofs;
+    int _load_dof = -1;
+
+    std::unique_ptr<StrainKernel> _strain_kernel;
+    std::unique_ptr<AssemblyKernel> _assembly_kernel;
+    std::shared_ptr<GradientDamage> _gdm;
+    IpLoop _loop;
+
+    Eigen::VectorXd _u;
+    Eigen::VectorXd _ebar;
+    Eigen::VectorXd _eps;
+    Eigen::VectorXd _residual;
+    Eigen::VectorXd _k_values;
+
+    Eigen::SparseMatrix<double> _K;
+    std::vector<long> _nnz_of_entry;
+    std::vector<long> _nnz_of_diagonal;
+    Eigen::SparseLU<Eigen::SparseMatrix<double>> _solver;
+
+    std::map<std::string, double> _seconds;
+    long _newton_iterations = 0;
+};
@@ -4,10 +4,53 @@
 #include "interfaces.h"
 #include "linear_elastic.h"
 #include "local_damage.h"
+#include "output_streamer.h"
+#include "parameter_sweep.h"
+#include "plane_stress.h"
 #include "plasticity.h"
+#include "device_loop.h"
+#include "distributed.h"
+#include "assembly_kernel.h"
+#include "bending_benchmark.h"
+#include "strain_kernel.h"
 
 namespace py = pybind11;
 
+//! @brief binds the constraint-specialized law templates for one `Constraint`
+//! value, e.g. LinearElasticT<PLANE_STRAIN> as "LinearElasticPlaneStrain"
+template <Constraint TC>
+void RegisterConstraintLaws(py::module& m, const std::string& suffix)
+{
+    pybind11::class_<LinearElasticT<TC>, std::shared_ptr<LinearElasticT<TC>>, LawInterface> linearElastic(
+            m, ("LinearElastic" + suffix).c_str());
+    linearElastic.def(pybind11::init<double, double>(), py::arg("E"), py::arg("nu"));
+
+    pybind11::class_<LocalDamageT<TC>, std::shared_ptr<LocalDamageT<TC>>, MechanicsLaw> local(
+            m, ("LocalDamage" + suffix).c_str());
+    local.def(pybind11::init<double, double, std::shared_ptr<DamageLawInterface>,
+                             std::shared_ptr<StrainNormInterface>>());
+    local.def("kappa", &LocalDamageT<TC>::Kappa);
+    local.def("set_kappa", &LocalDamageT<TC>::SetKappa);
+    local.def("set_prescreen", &LocalDamageT<TC>::SetPrescreen);
+
+    pybind11::class_<GradientDamageT<TC>, std::shared_ptr<GradientDamageT<TC>>, LawInterface> gdm(
+            m, ("GradientDamage" + suffix).c_str());
+    gdm.def(pybind11::init<double, double, std::shared_ptr<DamageLawInterface>,
+                           std::shared_ptr<StrainNormInterface>>());
+    gdm.def("kappa", &GradientDamageT<TC>::Kappa);
+    gdm.def("set_kappa", &GradientDamageT<TC>::SetKappa);
+    gdm.def("set_prescreen", &GradientDamageT<TC>::SetPrescreen);
+
+    using GdmExpMises = GradientDamageStatic<DamageLawExponential, ModMisesEeq, TC>;
+    pybind11::class_<GdmExpMises, std::shared_ptr<GdmExpMises>, LawInterface> gdmStatic(
+            m, ("GradientDamageExpMises" + suffix).c_str());
+    gdmStatic.def(pybind11::init<double, double, DamageLawExponential, ModMisesEeq>(), py::arg("E"), py::arg("nu"),
+                  py::arg("omega"), py::arg("strain_norm"));
+    gdmStatic.def("kappa", &GdmExpMises::Kappa);
+    gdmStatic.def("set_kappa", &GdmExpMises::SetKappa);
+    gdmStatic.def("set_prescreen", &GdmExpMises::SetPrescreen);
+}
+
 PYBIND11_MODULE(cpp, m)
 {
     // This was created with the help of
@@ -36,7 +79,8 @@ PYBIND11_MODULE(cpp, m)
             .value("E", Q::E)
             .value("KAPPA", Q::KAPPA)
             .value("DEEQ", Q::DEEQ)
-            .value("DSIGMA_DE", Q::DSIGMA_DE);
+            .value("DSIGMA_DE", Q::DSIGMA_DE)
+            .value("DEL_T", Q::DEL_T);
 
     m.def("g_dim", &Dim::G);
     m.def("q_dim", &Dim::Q);
@@ -51,10 +95,34 @@ PYBIND11_MODULE(cpp, m)
                py::arg("law"), py::arg("ips") = std::vector<int>());
     ipLoop.def("add_law", py::overload_cast<std::shared_ptr<LawInterface>, std::vector<int>>(&IpLoop::AddLaw),
                py::arg("law"), py::arg("ips") = std::vector<int>());
-    ipLoop.def("evaluate", &IpLoop::Evaluate, py::arg("eps"), py::arg("e") = Eigen::VectorXd());
-    ipLoop.def("update", &IpLoop::Update, py::arg("eps"), py::arg("e") = Eigen::VectorXd());
+    ipLoop.def("evaluate", &IpLoop::Evaluate, py::arg("eps"), py::arg("e") = Eigen::VectorXd(),
+               py::arg("threads") = 1);
+    ipLoop.def("update", &IpLoop::Update, py::arg("eps"), py::arg("e") = Eigen::VectorXd(), py::arg("threads") = 1);
+    ipLoop.def("evaluate_async", &IpLoop::EvaluateAsync, py::arg("eps"), py::arg("e") = Eigen::VectorXd(),
+               py::arg("threads") = 1);
+    ipLoop.def("wait", &IpLoop::Wait, py::call_guard<py::gil_scoped_release>());
+    ipLoop.def("commit", &IpLoop::Commit, py::call_guard<py::gil_scoped_release>());
+    ipLoop.def("save_state", &IpLoop::SaveState, py::arg("path"));
+    ipLoop.def("load_state", &IpLoop::LoadState, py::arg("path"));
+    ipLoop.def("transfer_from", &IpLoop::TransferFrom, py::arg("old_loop"), py::arg("old_coords"),
+               py::arg("new_coords"), py::arg("threads") = 1, py::call_guard<py::gil_scoped_release>());
+    ipLoop.def("evaluate_into", &IpLoop::EvaluateInto, py::arg("eps"), py::arg("sigma_out").noconvert(),
+               py::arg("dsigma_out").noconvert(), py::arg("e") = Eigen::VectorXd(), py::arg("threads") = 1);
     ipLoop.def("resize", &IpLoop::Resize);
-    ipLoop.def("get", &IpLoop::Get);
+    ipLoop.def("get", py::overload_cast<Q, bool>(&IpLoop::Get), py::arg("what"), py::arg("expand") = true);
+    ipLoop.def("get", py::overload_cast<const std::string&, bool>(&IpLoop::Get), py::arg("name"),
+               py::arg("expand") = true);
+    ipLoop.def("set_symmetric", &IpLoop::SetSymmetric);
+    ipLoop.def("set_single_precision", &IpLoop::SetSinglePrecision);
+    ipLoop.def("set_incremental", &IpLoop::SetIncremental, py::arg("rtol"));
+    ipLoop.def("set_block_size", &IpLoop::SetBlockSize, py::arg("block_size"));
+    ipLoop.def("set_del_t", &IpLoop::SetDeltaT, py::arg("del_t"));
+    ipLoop.def("mark_tangent_dirty", &IpLoop::MarkTangentDirty);
+    ipLoop.def("set_grouped", &IpLoop::SetGrouped, py::arg("grouped") = true);
+    ipLoop.def("set_instrumentation", &IpLoop::SetInstrumentation, py::arg("enabled"));
+    ipLoop.def("stats", &IpLoop::Stats);
+    ipLoop.def("reset_stats", &IpLoop::ResetStats);
+    ipLoop.def("get_f32", &IpLoop::GetF32);
     ipLoop.def("required_inputs", &IpLoop::RequiredInputs);
 
     pybind11::class_<LawInterface, std::shared_ptr<LawInterface>> law(m, "LawInterface");
@@ -98,6 +166,8 @@ PYBIND11_MODULE(cpp, m)
     local.def(pybind11::init<double, double, Constraint, std::shared_ptr<DamageLawInterface>,
                              std ::shared_ptr<StrainNormInterface>>());
     local.def("kappa", &LocalDamage::Kappa);
+    local.def("set_kappa", &LocalDamage::SetKappa);
+    local.def("set_prescreen", &LocalDamage::SetPrescreen);
 
     /*************************************************************************
      **   GRADIENT DAMAGE LAW
@@ -107,6 +177,18 @@ PYBIND11_MODULE(cpp, m)
     gdm.def(pybind11::init<double, double, Constraint, std::shared_ptr<DamageLawInterface>,
                            std ::shared_ptr<StrainNormInterface>>());
     gdm.def("kappa", &GradientDamage::Kappa);
+    gdm.def("set_kappa", &GradientDamage::SetKappa);
+    gdm.def("set_prescreen", &GradientDamage::SetPrescreen);
+
+    /*************************************************************************
+     **   CONSTRAINT-SPECIALIZED LAW TEMPLATES
+     *************************************************************************/
+
+    RegisterConstraintLaws<UNIAXIAL_STRAIN>(m, "UniaxialStrain");
+    RegisterConstraintLaws<UNIAXIAL_STRESS>(m, "UniaxialStress");
+    RegisterConstraintLaws<PLANE_STRAIN>(m, "PlaneStrain");
+    RegisterConstraintLaws<PLANE_STRESS>(m, "PlaneStress");
+    RegisterConstraintLaws<FULL>(m, "Full");
 
     /*************************************************************************
      **   PLASTICITY
@@ -120,4 +202,145 @@ PYBIND11_MODULE(cpp, m)
     RateIndependentHistory.def(pybind11::init<>());
     RateIndependentHistory.def("__call__", &RateIndependentHistory::Call);
 //     RateIndependentHistory.def_readonly("P", &RateIndependentHistory::_p);
+
+    pybind11::class_<MisesPlasticity, std::shared_ptr<MisesPlasticity>, LawInterface> mises(m, "MisesPlasticity");
+    mises.def(pybind11::init<double, double, Constraint, double, double, double, int>(), py::arg("E"), py::arg("nu"),
+              py::arg("constraint"), py::arg("sigma_y"), py::arg("H") = 0., py::arg("tol") = 1.e-9,
+              py::arg("max_iter") = 20);
+    mises.def("kappa", &MisesPlasticity::Kappa);
+    mises.def("eps_p", &MisesPlasticity::EpsP);
+
+    pybind11::class_<PerzynaViscoplasticity, std::shared_ptr<PerzynaViscoplasticity>, LawInterface> perzyna(
+            m, "PerzynaViscoplasticity");
+    perzyna.def(pybind11::init<double, double, Constraint, double, double, double, double, double, int>(),
+                py::arg("E"), py::arg("nu"), py::arg("constraint"), py::arg("sigma_y"), py::arg("eta"),
+                py::arg("exponent") = 1., py::arg("H") = 0., py::arg("tol") = 1.e-9, py::arg("max_iter") = 20);
+    perzyna.def("kappa", &PerzynaViscoplasticity::Kappa);
+    perzyna.def("eps_vp", &PerzynaViscoplasticity::EpsVp);
+
+    pybind11::class_<PlaneStressAdapter, std::shared_ptr<PlaneStressAdapter>, LawInterface> planeStress(
+            m, "PlaneStressAdapter");
+    planeStress.def(pybind11::init<std::shared_ptr<LawInterface>, double, int>(), py::arg("law"),
+                    py::arg("tol") = 1.e-10, py::arg("max_iter") = 20);
+
+    /*************************************************************************
+     **   PARAMETER SWEEP
+     *************************************************************************/
+    pybind11::class_<LinearElasticParameters> elasticParameters(m, "LinearElasticParameters");
+    elasticParameters.def(pybind11::init<double, double>(), py::arg("E"), py::arg("nu"));
+    elasticParameters.def_readwrite("E", &LinearElasticParameters::E);
+    elasticParameters.def_readwrite("nu", &LinearElasticParameters::nu);
+
+    pybind11::class_<LocalDamageParameters> damageParameters(m, "LocalDamageParameters");
+    damageParameters.def(pybind11::init<double, double, double, double, double>(), py::arg("E"), py::arg("nu"),
+                         py::arg("k0"), py::arg("alpha"), py::arg("beta"));
+    damageParameters.def_readwrite("E", &LocalDamageParameters::E);
+    damageParameters.def_readwrite("nu", &LocalDamageParameters::nu);
+    damageParameters.def_readwrite("k0", &LocalDamageParameters::k0);
+    damageParameters.def_readwrite("alpha", &LocalDamageParameters::alpha);
+    damageParameters.def_readwrite("beta", &LocalDamageParameters::beta);
+
+    pybind11::class_<ParameterSweep> sweep(m, "ParameterSweep");
+    sweep.def("resize", &ParameterSweep::Resize);
+    sweep.def("evaluate", &ParameterSweep::Evaluate, py::arg("eps"), py::arg("threads") = 1,
+              py::call_guard<py::gil_scoped_release>());
+    sweep.def("sigma", &ParameterSweep::Sigma);
+    sweep.def("commit", &ParameterSweep::Commit);
+    sweep.def("num_samples", &ParameterSweep::NumSamples);
+
+    pybind11::class_<LinearElasticSweep, ParameterSweep> elasticSweep(m, "LinearElasticSweep");
+    elasticSweep.def(pybind11::init<const std::vector<LinearElasticParameters>&, Constraint>(), py::arg("samples"),
+                     py::arg("constraint"));
+
+    pybind11::class_<LocalDamageSweep, ParameterSweep> damageSweep(m, "LocalDamageSweep");
+    damageSweep.def(pybind11::init<const std::vector<LocalDamageParameters>&, double, Constraint>(),
+                    py::arg("samples"), py::arg("k"), py::arg("constraint"));
+    damageSweep.def("kappa", &LocalDamageSweep::Kappa);
+    damageSweep.def("set_kappa", &LocalDamageSweep::SetKappa, py::arg("kappa"));
+
+    /*************************************************************************
+     **   STRAIN EVALUATION KERNEL
+     *************************************************************************/
+    pybind11::class_<StrainKernel> strainKernel(m, "StrainKernel");
+    strainKernel.def(pybind11::init<Eigen::MatrixXi, Eigen::MatrixXd, int>(), py::arg("dofmap"), py::arg("b"),
+                     py::arg("q"));
+    strainKernel.def("compute", &StrainKernel::Compute, py::arg("u"), py::arg("threads") = 1);
+    strainKernel.def("compute_into", &StrainKernel::ComputeInto, py::arg("u"), py::arg("out").noconvert(),
+                     py::arg("threads") = 1);
+    strainKernel.def("num_ips", &StrainKernel::NumIps);
+
+    pybind11::class_<AssemblyKernel> assemblyKernel(m, "AssemblyKernel");
+    assemblyKernel.def(pybind11::init<Eigen::MatrixXi, Eigen::MatrixXd, Eigen::VectorXd, int>(), py::arg("dofmap"),
+                       py::arg("b"), py::arg("weights"), py::arg("q"));
+    assemblyKernel.def("coo_indices", &AssemblyKernel::CooIndices);
+    assemblyKernel.def("assemble_into",
+                       py::overload_cast<Eigen::Ref<const Eigen::VectorXd>, Eigen::Ref<const Eigen::VectorXd>,
+                                         Eigen::Ref<Eigen::VectorXd>, Eigen::Ref<Eigen::VectorXd>, int>(
+                               &AssemblyKernel::AssembleInto, py::const_),
+                       py::arg("sigma"), py::arg("dsigma"), py::arg("residual").noconvert(),
+                       py::arg("k_values").noconvert(), py::arg("threads") = 1);
+    assemblyKernel.def("assemble_into",
+                       py::overload_cast<const IpLoop&, Eigen::Ref<Eigen::VectorXd>, Eigen::Ref<Eigen::VectorXd>, int>(
+                               &AssemblyKernel::AssembleInto, py::const_),
+                       py::arg("loop"), py::arg("residual").noconvert(), py::arg("k_values").noconvert(),
+                       py::arg("threads") = 1);
+    assemblyKernel.def("num_ips", &AssemblyKernel::NumIps);
+    assemblyKernel.def("num_cells", &AssemblyKernel::NumCells);
+
+    /*************************************************************************
+     **   STREAMING OUTPUT
+     *************************************************************************/
+    pybind11::class_<OutputStreamer> streamer(m, "OutputStreamer");
+    streamer.def(pybind11::init<IpLoop&, const std::string&>(), py::arg("loop"), py::arg("path"),
+                 py::keep_alive<1, 2>());
+    streamer.def("register", py::overload_cast<Q>(&OutputStreamer::Register), py::arg("what"));
+    streamer.def("register_history", &OutputStreamer::RegisterHistory, py::arg("name"));
+    streamer.def("write_frame", &OutputStreamer::WriteFrame, py::arg("time") = 0.);
+    streamer.def("flush", &OutputStreamer::Flush, py::call_guard<py::gil_scoped_release>());
+    streamer.def_static("read_frames",
+                        [](const std::string& path) {
+                            std::vector<std::string> names;
+                            auto frames = OutputStreamer::ReadFrames(path, &names);
+                            return std::make_pair(names, frames);
+                        },
+                        py::arg("path"));
+
+    /*************************************************************************
+     **   DEVICE (CUDA) BACKEND
+     *************************************************************************/
+    pybind11::class_<DeviceIpLoop> deviceLoop(m, "DeviceIpLoop");
+    deviceLoop.def(pybind11::init<double, double, Constraint>(), py::arg("E"), py::arg("nu"), py::arg("constraint"));
+    deviceLoop.def(pybind11::init<double, double, Constraint, double, double, double, double>(), py::arg("E"),
+                   py::arg("nu"), py::arg("constraint"), py::arg("k0"), py::arg("alpha"), py::arg("beta"),
+                   py::arg("k"));
+    deviceLoop.def("resize", &DeviceIpLoop::Resize, py::arg("n"));
+    deviceLoop.def("evaluate", &DeviceIpLoop::Evaluate, py::arg("eps"), py::arg("e") = Eigen::VectorXd());
+    deviceLoop.def("get", &DeviceIpLoop::Get, py::arg("what"));
+    deviceLoop.def("commit", &DeviceIpLoop::Commit);
+    deviceLoop.def("kappa", &DeviceIpLoop::Kappa);
+    deviceLoop.def("set_kappa", &DeviceIpLoop::SetKappa);
+    deviceLoop.def("on_device", &DeviceIpLoop::OnDevice);
+    deviceLoop.def_static("device_available", &DeviceIpLoop::DeviceAvailable);
+
+    /*************************************************************************
+     **   BENCHMARK DRIVER
+     *************************************************************************/
+    pybind11::class_<BendingBenchmark> bending(m, "BendingBenchmark");
+    bending.def(pybind11::init<int, int, int>(), py::arg("nx"), py::arg("ny"), py::arg("threads") = 1);
+    bending.def("run", &BendingBenchmark::Run, py::arg("steps"), py::arg("u_max"),
+                py::call_guard<py::gil_scoped_release>());
+    bending.def("num_ips", &BendingBenchmark::NumIps);
+    bending.def("num_cells", &BendingBenchmark::NumCells);
+    bending.def("num_dofs", &BendingBenchmark::NumDofs);
+
+    /*************************************************************************
+     **   DISTRIBUTED (MPI) HELPERS
+     *************************************************************************/
+    pybind11::class_<IpLoopPartition> partition(m, "IpLoopPartition");
+    partition.def(pybind11::init<int>(), py::arg("n_local"));
+    partition.def("offset", &IpLoopPartition::Offset);
+    partition.def("num_ips_global", &IpLoopPartition::NumIpsGlobal);
+    partition.def("ips_per_rank", &IpLoopPartition::IpsPerRank);
+    partition.def("gather", &IpLoopPartition::Gather);
+    partition.def("scatter", &IpLoopPartition::Scatter);
 }
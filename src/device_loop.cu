@@ -0,0 +1,336 @@
+#include "device_loop.h"
+#include <cuda_runtime.h>
+
+//! CUDA backends of DeviceIpLoop. Everything per-IP lives in flat device
+//! arrays; constants (C, T3D) are uploaded once at construction, kappa stays
+//! resident across steps with a device-pointer swap in Commit.
+
+namespace
+{
+
+void Check(cudaError_t status)
+{
+    if (status != cudaSuccess)
+        throw std::runtime_error(std::string("CUDA error: ") + cudaGetErrorString(status));
+}
+
+template <typename T>
+T* DeviceAlloc(long n)
+{
+    T* ptr = nullptr;
+    Check(cudaMalloc(&ptr, n * sizeof(T)));
+    return ptr;
+}
+
+constexpr int BLOCK = 256;
+
+//! sigma = C eps, dsigma = C; C is q x q column-major
+__global__ void LinearElasticKernel(const double* eps, const double* C, double* sigma, double* dsigma, int q, int n)
+{
+    const int ip = blockIdx.x * blockDim.x + threadIdx.x;
+    if (ip >= n)
+        return;
+
+    for (int r = 0; r < q; ++r)
+    {
+        double s = 0.;
+        for (int col = 0; col < q; ++col)
+            s += C[r + col * q] * eps[ip * q + col];
+        sigma[ip * q + r] = s;
+    }
+    for (int e = 0; e < q * q; ++e)
+        dsigma[ip * q * q + e] = C[e];
+}
+
+//! gradient damage: kappa update from the nonlocal input, exponential
+//! omega(kappa), modified Mises eeq/deeq, elastic constants as above
+__global__ void GradientDamageKernel(const double* eps, const double* neeq, const double* C, const double* T3D,
+                                     const double* kappa_old, double* kappa_trial, double k0, double alpha, double beta,
+                                     double K1, double K2, double* eeq_out, double* deeq_out, double* sigma,
+                                     double* dsigma_de, double* dsigma_deps, int q, int n)
+{
+    const int ip = blockIdx.x * blockDim.x + threadIdx.x;
+    if (ip >= n)
+        return;
+
+    // kappa update
+    const double e = neeq[ip];
+    const double kappa0 = kappa_old[ip];
+    const double kappa = e >= kappa0 ? e : kappa0;
+    const double dkappa = e >= kappa0 ? 1. : 0.;
+    kappa_trial[ip] = kappa;
+
+    // exponential damage law
+    double omega = 0., domega = 0.;
+    if (kappa > k0)
+    {
+        const double ex = exp(beta * (k0 - kappa));
+        omega = 1. - k0 / kappa * (1. - alpha + alpha * ex);
+        domega = k0 / kappa * ((1. / kappa + beta) * alpha * ex + (1. - alpha) / kappa);
+    }
+
+    // modified Mises norm: 3D transformation, invariants, norm, derivative
+    double e3[6];
+    for (int r = 0; r < 6; ++r)
+    {
+        double s = 0.;
+        for (int col = 0; col < q; ++col)
+            s += T3D[r + col * 6] * eps[ip * q + col];
+        e3[r] = s;
+    }
+    const double I1 = e3[0] + e3[1] + e3[2];
+    const double J2 = ((e3[0] - e3[1]) * (e3[0] - e3[1]) + (e3[1] - e3[2]) * (e3[1] - e3[2]) +
+                       (e3[2] - e3[0]) * (e3[2] - e3[0])) /
+                              6. +
+                      0.25 * (e3[3] * e3[3] + e3[4] * e3[4] + e3[5] * e3[5]);
+    const double A = sqrt(K1 * K1 * I1 * I1 + K2 * J2) + 1.e-14;
+    eeq_out[ip] = K1 * I1 + A;
+    const double deeq_dI1 = K1 + K1 * K1 * I1 / A;
+    const double deeq_dJ2 = K2 / (2. * A);
+
+    double deeq3[6];
+    deeq3[0] = deeq_dI1 + deeq_dJ2 * (2. * e3[0] - e3[1] - e3[2]) / 3.;
+    deeq3[1] = deeq_dI1 + deeq_dJ2 * (2. * e3[1] - e3[2] - e3[0]) / 3.;
+    deeq3[2] = deeq_dI1 + deeq_dJ2 * (2. * e3[2] - e3[0] - e3[1]) / 3.;
+    deeq3[3] = deeq_dJ2 * 0.5 * e3[3];
+    deeq3[4] = deeq_dJ2 * 0.5 * e3[4];
+    deeq3[5] = deeq_dJ2 * 0.5 * e3[5];
+    for (int col = 0; col < q; ++col)
+    {
+        double s = 0.;
+        for (int r = 0; r < 6; ++r)
+            s += T3D[r + col * 6] * deeq3[r];
+        deeq_out[ip * q + col] = s;
+    }
+
+    // stresses and tangents
+    for (int r = 0; r < q; ++r)
+    {
+        double s = 0.;
+        for (int col = 0; col < q; ++col)
+            s += C[r + col * q] * eps[ip * q + col];
+        sigma[ip * q + r] = (1. - omega) * s;
+        dsigma_de[ip * q + r] = -s * domega * dkappa;
+    }
+    for (int e2 = 0; e2 < q * q; ++e2)
+        dsigma_deps[ip * q * q + e2] = (1. - omega) * C[e2];
+}
+
+class CudaLinearElastic : public DeviceBackend
+{
+public:
+    CudaLinearElastic(const Eigen::MatrixXd& C)
+        : _q(C.rows())
+    {
+        _C = DeviceAlloc<double>(C.size());
+        Check(cudaMemcpy(_C, C.data(), C.size() * sizeof(double), cudaMemcpyHostToDevice));
+    }
+
+    ~CudaLinearElastic() override
+    {
+        cudaFree(_C);
+        Free();
+    }
+
+    void Resize(int n) override
+    {
+        Free();
+        _eps = DeviceAlloc<double>(static_cast<long>(n) * _q);
+        _sigma = DeviceAlloc<double>(static_cast<long>(n) * _q);
+        _dsigma = DeviceAlloc<double>(static_cast<long>(n) * _q * _q);
+    }
+
+    void Evaluate(const double* strains, const double*, int n) override
+    {
+        Check(cudaMemcpy(_eps, strains, static_cast<long>(n) * _q * sizeof(double), cudaMemcpyHostToDevice));
+        LinearElasticKernel<<<(n + BLOCK - 1) / BLOCK, BLOCK>>>(_eps, _C, _sigma, _dsigma, _q, n);
+        Check(cudaGetLastError());
+    }
+
+    void Download(Q what, double* host, int n) const override
+    {
+        if (what == SIGMA)
+            Check(cudaMemcpy(host, _sigma, static_cast<long>(n) * _q * sizeof(double), cudaMemcpyDeviceToHost));
+        else if (what == DSIGMA_DEPS)
+            Check(cudaMemcpy(host, _dsigma, static_cast<long>(n) * _q * _q * sizeof(double), cudaMemcpyDeviceToHost));
+        else
+            throw std::runtime_error("The requested output is not provided by this law!");
+    }
+
+    void Commit() override
+    {
+    }
+
+    void DownloadKappa(double*, int) const override
+    {
+        throw std::runtime_error("LinearElastic has no history!");
+    }
+
+    void UploadKappa(const double*, int) override
+    {
+        throw std::runtime_error("LinearElastic has no history!");
+    }
+
+private:
+    void Free()
+    {
+        cudaFree(_eps);
+        cudaFree(_sigma);
+        cudaFree(_dsigma);
+        _eps = _sigma = _dsigma = nullptr;
+    }
+
+    const int _q;
+    double* _C = nullptr;
+    double* _eps = nullptr;
+    double* _sigma = nullptr;
+    double* _dsigma = nullptr;
+};
+
+class CudaGradientDamage : public DeviceBackend
+{
+public:
+    CudaGradientDamage(const Eigen::MatrixXd& C, const Eigen::Matrix<double, 6, Eigen::Dynamic>& T3D, double k0,
+                       double alpha, double beta, double K1, double K2)
+        : _q(C.rows())
+        , _k0(k0)
+        , _alpha(alpha)
+        , _beta(beta)
+        , _K1(K1)
+        , _K2(K2)
+    {
+        _C = DeviceAlloc<double>(C.size());
+        Check(cudaMemcpy(_C, C.data(), C.size() * sizeof(double), cudaMemcpyHostToDevice));
+        _T3D = DeviceAlloc<double>(T3D.size());
+        Check(cudaMemcpy(_T3D, T3D.data(), T3D.size() * sizeof(double), cudaMemcpyHostToDevice));
+    }
+
+    ~CudaGradientDamage() override
+    {
+        cudaFree(_C);
+        cudaFree(_T3D);
+        Free();
+    }
+
+    void Resize(int n) override
+    {
+        Free();
+        _eps = DeviceAlloc<double>(static_cast<long>(n) * _q);
+        _neeq = DeviceAlloc<double>(n);
+        _eeq = DeviceAlloc<double>(n);
+        _deeq = DeviceAlloc<double>(static_cast<long>(n) * _q);
+        _sigma = DeviceAlloc<double>(static_cast<long>(n) * _q);
+        _dsigma_de = DeviceAlloc<double>(static_cast<long>(n) * _q);
+        _dsigma_deps = DeviceAlloc<double>(static_cast<long>(n) * _q * _q);
+        _kappa = DeviceAlloc<double>(n);
+        _kappa_trial = DeviceAlloc<double>(n);
+        Check(cudaMemset(_kappa, 0, n * sizeof(double)));
+        Check(cudaMemset(_kappa_trial, 0, n * sizeof(double)));
+    }
+
+    void Evaluate(const double* strains, const double* neeq, int n) override
+    {
+        Check(cudaMemcpy(_eps, strains, static_cast<long>(n) * _q * sizeof(double), cudaMemcpyHostToDevice));
+        Check(cudaMemcpy(_neeq, neeq, n * sizeof(double), cudaMemcpyHostToDevice));
+        GradientDamageKernel<<<(n + BLOCK - 1) / BLOCK, BLOCK>>>(_eps, _neeq, _C, _T3D, _kappa, _kappa_trial, _k0,
+                                                                 _alpha, _beta, _K1, _K2, _eeq, _deeq, _sigma,
+                                                                 _dsigma_de, _dsigma_deps, _q, n);
+        Check(cudaGetLastError());
+    }
+
+    void Download(Q what, double* host, int n) const override
+    {
+        const double* src = nullptr;
+        long size = 0;
+        switch (what)
+        {
+        case EEQ:
+            src = _eeq;
+            size = n;
+            break;
+        case DEEQ:
+            src = _deeq;
+            size = static_cast<long>(n) * _q;
+            break;
+        case SIGMA:
+            src = _sigma;
+            size = static_cast<long>(n) * _q;
+            break;
+        case DSIGMA_DE:
+            src = _dsigma_de;
+            size = static_cast<long>(n) * _q;
+            break;
+        case DSIGMA_DEPS:
+            src = _dsigma_deps;
+            size = static_cast<long>(n) * _q * _q;
+            break;
+        default:
+            throw std::runtime_error("The requested output is not provided by this law!");
+        }
+        Check(cudaMemcpy(host, src, size * sizeof(double), cudaMemcpyDeviceToHost));
+    }
+
+    void Commit() override
+    {
+        // O(1), device-resident
+        std::swap(_kappa, _kappa_trial);
+    }
+
+    void DownloadKappa(double* host, int n) const override
+    {
+        Check(cudaMemcpy(host, _kappa, n * sizeof(double), cudaMemcpyDeviceToHost));
+    }
+
+    void UploadKappa(const double* host, int n) override
+    {
+        Check(cudaMemcpy(_kappa, host, n * sizeof(double), cudaMemcpyHostToDevice));
+    }
+
+private:
+    void Free()
+    {
+        for (double** ptr : {&_eps, &_neeq, &_eeq, &_deeq, &_sigma, &_dsigma_de, &_dsigma_deps, &_kappa, &_kappa_trial})
+        {
+            cudaFree(*ptr);
+            *ptr = nullptr;
+        }
+    }
+
+    const int _q;
+    const double _k0;
+    const double _alpha;
+    const double _beta;
+    const double _K1;
+    const double _K2;
+    double* _C = nullptr;
+    double* _T3D = nullptr;
+    double* _eps = nullptr;
+    double* _neeq = nullptr;
+    double* _eeq = nullptr;
+    double* _deeq = nullptr;
+    double* _sigma = nullptr;
+    double* _dsigma_de = nullptr;
+    double* _dsigma_deps = nullptr;
+    double* _kappa = nullptr;
+    double* _kappa_trial = nullptr;
+};
+
+} // namespace
+
+std::unique_ptr<DeviceBackend> MakeDeviceLinearElastic(const Eigen::MatrixXd& C)
+{
+    return std::unique_ptr<DeviceBackend>(new CudaLinearElastic(C));
+}
+
+std::unique_ptr<DeviceBackend> MakeDeviceGradientDamage(const Eigen::MatrixXd& C,
+                                                        const Eigen::Matrix<double, 6, Eigen::Dynamic>& T3D, double k0,
+                                                        double alpha, double beta, double K1, double K2)
+{
+    return std::unique_ptr<DeviceBackend>(new CudaGradientDamage(C, T3D, k0, alpha, beta, K1, K2));
+}
+
+bool CudaDeviceAvailable()
+{
+    int count = 0;
+    return cudaGetDeviceCount(&count) == cudaSuccess and count > 0;
+}
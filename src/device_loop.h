@@ -0,0 +1,169 @@
+#pragma once
+#include "interfaces.h"
+#include "linear_elastic.h"
+#include "local_damage.h"
+#include <memory>
+
+//! @brief device side of DeviceIpLoop, implemented in device_loop.cu
+//!
+//! Strain upload and stress/tangent download are the only transfers; the
+//! history (kappa) is resident on the device across steps.
+class DeviceBackend
+{
+public:
+    virtual ~DeviceBackend() = default;
+    virtual void Resize(int n) = 0;
+    virtual void Evaluate(const double* strains, const double* neeq, int n) = 0;
+    virtual void Download(Q what, double* host, int n) const = 0;
+    virtual void Commit() = 0;
+    virtual void DownloadKappa(double* host, int n) const = 0;
+    virtual void UploadKappa(const double* host, int n) = 0;
+};
+
+#ifdef CONSTITUTIVE_WITH_CUDA
+std::unique_ptr<DeviceBackend> MakeDeviceLinearElastic(const Eigen::MatrixXd& C);
+std::unique_ptr<DeviceBackend> MakeDeviceGradientDamage(const Eigen::MatrixXd& C,
+                                                        const Eigen::Matrix<double, 6, Eigen::Dynamic>& T3D, double k0,
+                                                        double alpha, double beta, double K1, double K2);
+bool CudaDeviceAvailable();
+#endif
+
+//! @brief GPU-resident constitutive evaluation for the embarrassingly
+//! parallel per-IP sweep
+//!
+//! Covers LinearElastic and GradientDamage (DamageLawExponential +
+//! ModMisesEeq) with device kernels: strains are uploaded, SIGMA and the
+//! tangents downloaded, and kappa lives on the device across steps with a
+//! device-side trial/commit swap. Compiled without CONSTITUTIVE_WITH_CUDA
+//! (cmake option CONSTITUTIVE_CUDA) or when no device is present, it falls
+//! back to the existing CPU IpLoop with the matching laws -- same API,
+//! same results.
+class DeviceIpLoop
+{
+public:
+    //! @brief linear elastic device loop
+    DeviceIpLoop(double E, double nu, Constraint c)
+        : _q(Dim::Q(c))
+    {
+#ifdef CONSTITUTIVE_WITH_CUDA
+        if (CudaDeviceAvailable())
+            _backend = MakeDeviceLinearElastic(C(E, nu, c));
+#endif
+        if (not _backend)
+            _cpu.AddLaw(std::make_shared<LinearElastic>(E, nu, c), {});
+    }
+
+    //! @brief gradient damage device loop, exponential damage law and
+    //! modified Mises strain norm
+    DeviceIpLoop(double E, double nu, Constraint c, double k0, double alpha, double beta, double k)
+        : _q(Dim::Q(c))
+    {
+#ifdef CONSTITUTIVE_WITH_CUDA
+        if (CudaDeviceAvailable())
+        {
+            const double K1 = (k - 1.) / (2. * k * (1. - 2. * nu));
+            const double K2 = 3. / (k * (1. + nu) * (1. + nu));
+            _backend = MakeDeviceGradientDamage(C(E, nu, c), T3D(nu, c), k0, alpha, beta, K1, K2);
+        }
+#endif
+        if (not _backend)
+        {
+            _gdm = std::make_shared<GradientDamage>(E, nu, c, std::make_shared<DamageLawExponential>(k0, alpha, beta),
+                                                    std::make_shared<ModMisesEeq>(k, nu, c));
+            _cpu.AddLaw(_gdm, {});
+        }
+    }
+
+    //! @brief true iff this loop runs on a device
+    bool OnDevice() const
+    {
+        return _backend != nullptr;
+    }
+
+    void Resize(int n)
+    {
+        _n = n;
+        if (_backend)
+            _backend->Resize(n);
+        else
+            _cpu.Resize(n);
+    }
+
+    void Evaluate(const Eigen::VectorXd& all_strains, const Eigen::VectorXd& all_neeq = Eigen::VectorXd())
+    {
+        if (_backend)
+            _backend->Evaluate(all_strains.data(), all_neeq.data(), _n);
+        else
+            _cpu.Evaluate(all_strains, all_neeq);
+    }
+
+    Eigen::VectorXd Get(Q what)
+    {
+        if (not _backend)
+            return _cpu.Get(what);
+        Eigen::VectorXd host(static_cast<long>(_n) * ValuesPerIp(what));
+        _backend->Download(what, host.data(), _n);
+        return host;
+    }
+
+    void Commit()
+    {
+        if (_backend)
+            _backend->Commit();
+        else
+            _cpu.Commit();
+    }
+
+    Eigen::VectorXd Kappa()
+    {
+        if (not _backend)
+            return _gdm ? _gdm->Kappa() : Eigen::VectorXd();
+        Eigen::VectorXd host(_n);
+        _backend->DownloadKappa(host.data(), _n);
+        return host;
+    }
+
+    //! @brief restores the committed history, e.g. after a checkpoint
+    void SetKappa(const Eigen::VectorXd& kappa)
+    {
+        if (kappa.size() != _n)
+            throw std::runtime_error("The kappa size does not match the number of IPs!");
+        if (_backend)
+            _backend->UploadKappa(kappa.data(), _n);
+        else if (_gdm)
+            _gdm->SetKappa(kappa);
+    }
+
+    static bool DeviceAvailable()
+    {
+#ifdef CONSTITUTIVE_WITH_CUDA
+        return CudaDeviceAvailable();
+#else
+        return false;
+#endif
+    }
+
+private:
+    int ValuesPerIp(Q what) const
+    {
+        switch (what)
+        {
+        case EEQ:
+            return 1;
+        case SIGMA:
+        case DEEQ:
+        case DSIGMA_DE:
+            return _q;
+        case DSIGMA_DEPS:
+            return _q * _q;
+        default:
+            throw std::runtime_error("The requested output is not provided by this law!");
+        }
+    }
+
+    const int _q;
+    int _n = 0;
+    std::unique_ptr<DeviceBackend> _backend;
+    IpLoop _cpu;
+    std::shared_ptr<GradientDamage> _gdm;
+};
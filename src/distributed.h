@@ -0,0 +1,121 @@
+#pragma once
+#include "interfaces.h"
+
+#ifdef CONSTITUTIVE_WITH_MPI
+#include <mpi.h>
+#endif
+
+//! @brief MPI decomposition of the IPs across ranks
+//!
+//! The IpLoop itself stays rank-local -- each rank numbers its IPs 0..n-1.
+//! This class provides the global numbering on top of that (offset of the
+//! rank-local IP 0, per-rank load statistics) plus the collectives to
+//! gather/scatter per-IP fields like GradientDamage::Kappa() for
+//! checkpointing. Compiled without CONSTITUTIVE_WITH_MPI (cmake option
+//! CONSTITUTIVE_MPI) it degenerates to a single-rank identity mapping.
+class IpLoopPartition
+{
+public:
+    IpLoopPartition(int n_local)
+        : _n_local(n_local)
+    {
+#ifdef CONSTITUTIVE_WITH_MPI
+        int size;
+        MPI_Comm_size(MPI_COMM_WORLD, &size);
+        MPI_Comm_rank(MPI_COMM_WORLD, &_rank);
+        _ips_per_rank.resize(size);
+        MPI_Allgather(&_n_local, 1, MPI_INT, _ips_per_rank.data(), 1, MPI_INT, MPI_COMM_WORLD);
+#else
+        _ips_per_rank = {n_local};
+#endif
+        _offset = std::accumulate(_ips_per_rank.begin(), _ips_per_rank.begin() + _rank, 0);
+    }
+
+    //! @brief global index of this rank's IP 0
+    int Offset() const
+    {
+        return _offset;
+    }
+
+    int NumIpsGlobal() const
+    {
+        return std::accumulate(_ips_per_rank.begin(), _ips_per_rank.end(), 0);
+    }
+
+    //! @brief IP counts of all ranks -- the per-rank load statistics
+    const std::vector<int>& IpsPerRank() const
+    {
+        return _ips_per_rank;
+    }
+
+    //! @brief gathers a rank-local per-IP field into the global field on rank 0
+    //!
+    //! The number of values per IP (1 for kappa, q for stresses, ...) is
+    //! deduced from the field size. Non-root ranks return an empty vector.
+    Eigen::VectorXd Gather(const Eigen::VectorXd& local_field) const
+    {
+        const int values_per_ip = ValuesPerIp(local_field.size(), _n_local);
+#ifdef CONSTITUTIVE_WITH_MPI
+        std::vector<int> counts, displs;
+        Layout(values_per_ip, counts, displs);
+
+        Eigen::VectorXd global_field(_rank == 0 ? NumIpsGlobal() * values_per_ip : 0);
+        MPI_Gatherv(local_field.data(), local_field.size(), MPI_DOUBLE, global_field.data(), counts.data(),
+                    displs.data(), MPI_DOUBLE, 0, MPI_COMM_WORLD);
+        return global_field;
+#else
+        (void)values_per_ip;
+        return local_field;
+#endif
+    }
+
+    //! @brief scatters a global per-IP field (significant on rank 0) back
+    //! into the rank-local piece
+    Eigen::VectorXd Scatter(const Eigen::VectorXd& global_field) const
+    {
+#ifdef CONSTITUTIVE_WITH_MPI
+        int values_per_ip = _rank == 0 ? ValuesPerIp(global_field.size(), NumIpsGlobal()) : 0;
+        MPI_Bcast(&values_per_ip, 1, MPI_INT, 0, MPI_COMM_WORLD);
+
+        std::vector<int> counts, displs;
+        Layout(values_per_ip, counts, displs);
+
+        Eigen::VectorXd local_field(_n_local * values_per_ip);
+        MPI_Scatterv(global_field.data(), counts.data(), displs.data(), MPI_DOUBLE, local_field.data(),
+                     local_field.size(), MPI_DOUBLE, 0, MPI_COMM_WORLD);
+        return local_field;
+#else
+        return global_field;
+#endif
+    }
+
+private:
+    static int ValuesPerIp(int field_size, int n)
+    {
+        if (n == 0)
+            return 0;
+        if (field_size % n != 0)
+            throw std::runtime_error("The field size is not a multiple of the number of IPs!");
+        return field_size / n;
+    }
+
+#ifdef CONSTITUTIVE_WITH_MPI
+    void Layout(int values_per_ip, std::vector<int>& counts, std::vector<int>& displs) const
+    {
+        counts.resize(_ips_per_rank.size());
+        displs.resize(_ips_per_rank.size());
+        int displ = 0;
+        for (unsigned rank = 0; rank < _ips_per_rank.size(); ++rank)
+        {
+            counts[rank] = _ips_per_rank[rank] * values_per_ip;
+            displs[rank] = displ;
+            displ += counts[rank];
+        }
+    }
+#endif
+
+    const int _n_local;
+    int _rank = 0;
+    int _offset = 0;
+    std::vector<int> _ips_per_rank;
+};
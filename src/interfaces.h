@@ -1,9 +1,28 @@
 #pragma once
 #include <eigen3/Eigen/Core>
+#include <cmath>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
 #include <exception>
+#include <limits>
+#include <fstream>
+#include <future>
+#include <map>
+#include <string>
 #include <vector>
 #include <numeric>
 #include <memory>
+#include <algorithm>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 enum Constraint
 {
@@ -24,6 +43,7 @@ enum Q
     EEQ,
     DEEQ,
     KAPPA,
+    DEL_T,
     LAST
 };
 
@@ -41,34 +61,172 @@ public:
 
     void Resize(int n)
     {
-        data.setZero(n * _rows * _cols);
+        if (_single)
+            data_f.setZero(n * ValuesPerIp());
+        else
+            data.setZero(n * ValuesPerIp());
+    }
+
+    //! @brief switches a square slot to packed-symmetric storage
+    //!
+    //! Only the lower triangle (rows*(rows+1)/2 values per IP, 21 instead of
+    //! 36 for a 3D tangent) is stored. `Set` packs -- dropping the upper
+    //! triangle of non-symmetric input -- and `Get` expands, so laws writing
+    //! via `Set` work unchanged. The fixed-size `GetMap` writes of the
+    //! constraint-specialized law templates require the expanded layout.
+    //! Call before `Resize`.
+    void SetSymmetric(bool symmetric = true)
+    {
+        if (symmetric and _rows != _cols)
+            throw std::runtime_error("Only square QValues can be stored packed-symmetric!");
+        _symmetric = symmetric;
+    }
+
+    bool IsSymmetric() const
+    {
+        return _symmetric;
+    }
+
+    //! @brief switches the slot to float32 storage
+    //!
+    //! Laws keep computing in double; `Set` casts on store and `Get` casts
+    //! back. For stress/tangent fields of explicit dynamics this halves the
+    //! footprint and memory traffic. As with the packed-symmetric mode, the
+    //! `GetMap` accessors require the plain double layout. Call before
+    //! `Resize`.
+    void SetSinglePrecision(bool single = true)
+    {
+        _single = single;
+    }
+
+    bool IsSinglePrecision() const
+    {
+        return _single;
+    }
+
+    //! @brief number of stored values per IP, packing aware
+    int ValuesPerIp() const
+    {
+        return _symmetric ? _rows * (_rows + 1) / 2 : _rows * _cols;
     }
 
     void Set(double value, int i)
     {
         assert(_rows == 1);
         assert(_cols == 1);
-        data[i] = value;
+        if (_single)
+            data_f[Index(i)] = static_cast<float>(value);
+        else
+            data[Index(i)] = value;
     }
 
-    void Set(Eigen::MatrixXd value, int i)
+    //! @brief evaluates any Eigen expression directly into the storage of IP `i`
+    template <typename TDerived>
+    void Set(const Eigen::MatrixBase<TDerived>& value, int i)
     {
         assert(value.rows() == _rows);
         assert(value.cols() == _cols);
-        data.segment(_rows * _cols * i, _rows * _cols) = Eigen::Map<Eigen::VectorXd>(value.data(), value.size());
+        if (_symmetric)
+            SetSymmetric(value, i);
+        else if (_single)
+            Eigen::Map<Eigen::MatrixXf>(data_f.data() + _rows * _cols * Index(i), _rows, _cols) =
+                    value.template cast<float>();
+        else
+            GetMap(i) = value;
+    }
+
+    //! @brief packs the lower triangle of `value` into the storage of IP `i`
+    template <typename TDerived>
+    void SetSymmetric(const Eigen::MatrixBase<TDerived>& value, int i)
+    {
+        assert(_symmetric);
+        int k = ValuesPerIp() * Index(i);
+        for (int col = 0; col < _cols; ++col)
+            for (int row = col; row < _rows; ++row, ++k)
+            {
+                if (_single)
+                    data_f[k] = static_cast<float>(value(row, col));
+                else
+                    data[k] = value(row, col);
+            }
     }
 
     double GetScalar(int i) const
     {
         assert(_rows == 1);
         assert(_cols == 1);
-        return data[i];
+        return _single ? data_f[Index(i)] : data[Index(i)];
     }
 
     Eigen::MatrixXd Get(int i) const
     {
-        Eigen::VectorXd ip_values = data.segment(_rows * _cols * i, _rows * _cols);
-        return Eigen::Map<Eigen::MatrixXd>(ip_values.data(), _rows, _cols);
+        if (_symmetric)
+            return GetSymmetric(i);
+        if (_single)
+            return Eigen::Map<const Eigen::MatrixXf>(data_f.data() + _rows * _cols * Index(i), _rows, _cols)
+                    .cast<double>();
+        return GetMap(i);
+    }
+
+    //! @brief expands the packed storage of IP `i` into a full matrix
+    Eigen::MatrixXd GetSymmetric(int i) const
+    {
+        assert(_symmetric);
+        Eigen::MatrixXd m(_rows, _cols);
+        int k = ValuesPerIp() * Index(i);
+        for (int col = 0; col < _cols; ++col)
+            for (int row = col; row < _rows; ++row, ++k)
+            {
+                const double value = _single ? data_f[k] : data[k];
+                m(row, col) = value;
+                m(col, row) = value;
+            }
+        return m;
+    }
+
+    //! @brief zero-copy view on the values of IP `i`, expanded layout only
+    //!
+    //! Laws accessing their slots through GetMap cannot work on the
+    //! packed-symmetric or float32 storage; this must throw (not just
+    //! assert) or the map would silently dereference the unused double
+    //! array in release builds.
+    Eigen::Map<const Eigen::MatrixXd> GetMap(int i) const
+    {
+        RequirePlainLayout();
+        return Eigen::Map<const Eigen::MatrixXd>(data.data() + _rows * _cols * Index(i), _rows, _cols);
+    }
+
+    Eigen::Map<Eigen::MatrixXd> GetMap(int i)
+    {
+        RequirePlainLayout();
+        return Eigen::Map<Eigen::MatrixXd>(data.data() + _rows * _cols * Index(i), _rows, _cols);
+    }
+
+    //! @brief fixed-size variant of GetMap for compile-time sized laws
+    template <int TRows, int TCols>
+    Eigen::Map<const Eigen::Matrix<double, TRows, TCols>> GetMap(int i) const
+    {
+        assert(TRows == _rows);
+        assert(TCols == _cols);
+        RequirePlainLayout();
+        return Eigen::Map<const Eigen::Matrix<double, TRows, TCols>>(data.data() + TRows * TCols * Index(i));
+    }
+
+    template <int TRows, int TCols>
+    Eigen::Map<Eigen::Matrix<double, TRows, TCols>> GetMap(int i)
+    {
+        assert(TRows == _rows);
+        assert(TCols == _cols);
+        RequirePlainLayout();
+        return Eigen::Map<Eigen::Matrix<double, TRows, TCols>>(data.data() + TRows * TCols * Index(i));
+    }
+
+    void RequirePlainLayout() const
+    {
+        if (_symmetric or _single)
+            throw std::runtime_error(
+                    "The zero-copy GetMap requires the plain double layout, but this slot is stored "
+                    "packed-symmetric or float32 -- this law does not support those storage modes!");
     }
 
     bool IsUsed() const
@@ -76,11 +234,29 @@ public:
         return _rows != 0;
     }
 
+    //! @brief turns this instance into a staging view for the IP range
+    //! starting at `offset`: laws keep addressing global IP indices while
+    //! the storage only holds the block, see the tiled IpLoop mode
+    void SetOffset(int offset)
+    {
+        _offset = offset;
+    }
+
 
     // private:
+    //! @brief storage index of the global IP index `i`
+    int Index(int i) const
+    {
+        return i - _offset;
+    }
+
     int _rows = 0;
     int _cols = 0;
+    int _offset = 0;
+    bool _symmetric = false;
+    bool _single = false;
     Eigen::VectorXd data;
+    Eigen::VectorXf data_f;
 };
 
 struct Dim
@@ -126,14 +302,135 @@ template <Constraint TC>
 using M = Eigen::Matrix<double, Dim::Q(TC), Dim::Q(TC)>;
 
 
+//! @brief maps per-IP field names to dense slot indices
+//!
+//! The `Q` enum entries are the predefined names ("eps", "sigma", ...) with
+//! their enum values as indices, so existing laws keep indexing by enum.
+//! Custom laws register additional names (backstress tensors, void
+//! fraction, ...) at `AddLaw` time and receive the next dense index -- no
+//! core enum edit and no rebuild of the other laws.
+class QRegistry
+{
+public:
+    QRegistry()
+    {
+        for (const char* name : {"eps", "e", "sigma", "dsigma_deps", "dsigma_de", "eeq", "deeq", "kappa", "del_t"})
+            Index(name);
+    }
+
+    //! @brief the dense index of `name`, registered on first use
+    int Index(const std::string& name)
+    {
+        const auto it = _indices.find(name);
+        if (it != _indices.end())
+            return it->second;
+        _indices[name] = _names.size();
+        _names.push_back(name);
+        return _names.size() - 1;
+    }
+
+    //! @brief the index of an already registered `name`
+    int Find(const std::string& name) const
+    {
+        const auto it = _indices.find(name);
+        if (it == _indices.end())
+            throw std::runtime_error("No field '" + name + "' is registered!");
+        return it->second;
+    }
+
+    const std::string& Name(int index) const
+    {
+        return _names.at(index);
+    }
+
+    int Size() const
+    {
+        return _names.size();
+    }
+
+    //! @brief registers `name` and returns its slot in `fields`, growing the
+    //! vector to the registry size -- the one-liner for laws declaring custom
+    //! fields: `registry.Slot("void_fraction", out) = QValues(1);`
+    QValues& Slot(const std::string& name, std::vector<QValues>& fields)
+    {
+        const int index = Index(name);
+        if (static_cast<int>(fields.size()) < Size())
+            fields.resize(Size());
+        return fields[index];
+    }
+
+private:
+    std::map<std::string, int> _indices;
+    std::vector<std::string> _names;
+};
+
 struct LawInterface
 {
     virtual void DefineOutputs(std::vector<QValues>& out) const = 0;
     virtual void DefineInputs(std::vector<QValues>& input) const = 0;
+
+    //! @brief declares law-specific named per-IP output fields beyond the
+    //! predefined `Q` slots, e.g.
+    //! `registry.Slot("void_fraction", out) = QValues(1);`
+    //!
+    //! Non-const so the law can cache the granted indices for its
+    //! `Evaluate`.
+    virtual void DefineNamedOutputs(QRegistry& registry, std::vector<QValues>& out)
+    {
+    }
     virtual void Evaluate(const std::vector<QValues>& input, std::vector<QValues>& out, int i) = 0;
+
+    //! @brief evaluates all IPs in `ips` in a single call
+    //!
+    //! Laws should override this with a loop over their own (non-virtual)
+    //! `Evaluate` to amortize the per-IP dispatch and let the compiler
+    //! inline and vectorize across the contiguous QValues storage.
+    virtual void EvaluateAll(const std::vector<QValues>& input, std::vector<QValues>& out, const std::vector<int>& ips)
+    {
+        for (int ip : ips)
+            Evaluate(input, out, ip);
+    }
+
     virtual void Update(const std::vector<QValues>& input, int i)
     {
     }
+
+    virtual void UpdateAll(const std::vector<QValues>& input, const std::vector<int>& ips)
+    {
+        for (int ip : ips)
+            Update(input, ip);
+    }
+
+    //! @brief makes the trial history written during the last `Evaluate` the
+    //! committed state -- an O(1) buffer swap instead of the re-evaluation
+    //! sweep that `Update` performs
+    virtual void Commit()
+    {
+    }
+
+    //! @brief named views on the committed history for checkpoint/restart
+    virtual std::vector<std::pair<std::string, QValues*>> HistoryFields()
+    {
+        return {};
+    }
+
+    //! @brief optional law-specific statistics merged into IpLoop::Stats,
+    //! e.g. the inner-iteration histogram of an iterative law
+    virtual std::map<std::string, Eigen::VectorXd> Stats() const
+    {
+        return {};
+    }
+
+    //! @brief declares DSIGMA_DEPS constant by filling `tangent`
+    //!
+    //! IpLoop then writes the tangent of all IPs once (at resize or after
+    //! MarkTangentDirty) and the law may skip the per-IP write in Evaluate.
+    virtual bool ConstantTangent(Eigen::MatrixXd& tangent) const
+    {
+        (void)tangent;
+        return false;
+    }
+
     virtual void Resize(int n)
     {
     }
@@ -153,6 +450,23 @@ public:
     {
     }
 
+    virtual void Commit()
+    {
+    }
+
+    //! @brief named views on the committed history for checkpoint/restart
+    virtual std::vector<std::pair<std::string, QValues*>> HistoryFields()
+    {
+        return {};
+    }
+
+    //! @brief declares the tangent constant, see LawInterface::ConstantTangent
+    virtual bool ConstantTangent(Eigen::MatrixXd& tangent) const
+    {
+        (void)tangent;
+        return false;
+    }
+
     virtual void Resize(int n)
     {
     }
@@ -182,13 +496,43 @@ public:
 
     void Evaluate(const std::vector<QValues>& input, std::vector<QValues>& out, int i) override
     {
-        auto eval = _law->Evaluate(input[EPS].Get(i), i);
+        auto eval = _law->Evaluate(input[EPS].GetMap(i), i);
         out[SIGMA].Set(eval.first, i);
         out[DSIGMA_DEPS].Set(eval.second, i);
     }
+    void EvaluateAll(const std::vector<QValues>& input, std::vector<QValues>& out, const std::vector<int>& ips) override
+    {
+        Eigen::MatrixXd unused;
+        if (_law->ConstantTangent(unused))
+        {
+            // IpLoop filled DSIGMA_DEPS once, only SIGMA is written per IP
+            for (int ip : ips)
+                out[SIGMA].Set(_law->Evaluate(input[EPS].GetMap(ip), ip).first, ip);
+            return;
+        }
+        for (int ip : ips)
+            MechanicsLawAdapter::Evaluate(input, out, ip);
+    }
+    bool ConstantTangent(Eigen::MatrixXd& tangent) const override
+    {
+        return _law->ConstantTangent(tangent);
+    }
     void Update(const std::vector<QValues>& input, int i) override
     {
-        _law->Update(input[EPS].Get(i), i);
+        _law->Update(input[EPS].GetMap(i), i);
+    }
+    void UpdateAll(const std::vector<QValues>& input, const std::vector<int>& ips) override
+    {
+        for (int ip : ips)
+            MechanicsLawAdapter::Update(input, ip);
+    }
+    void Commit() override
+    {
+        _law->Commit();
+    }
+    std::vector<std::pair<std::string, QValues*>> HistoryFields() override
+    {
+        return _law->HistoryFields();
     }
     void Resize(int n) override
     {
@@ -215,6 +559,7 @@ public:
         _ips.push_back(ips);
         law->DefineInputs(_inputs);
         law->DefineOutputs(_outputs);
+        law->DefineNamedOutputs(_registry, _outputs);
 
         if (_n != 0)
             Resize(_n);
@@ -229,16 +574,190 @@ public:
     virtual void Resize(int n)
     {
         _n = n;
+        _cache_valid = false;
+        _tangent_filled = false;
+        // un-group: the next FixIPs rebuilds the permutation from the
+        // original per-law lists instead of the already-remapped ranges
+        for (unsigned iLaw = 0; iLaw < _global_ips.size(); ++iLaw)
+            _ips[iLaw] = _global_ips[iLaw];
+        _global_ips.clear();
+        _perm.clear();
         for (auto& qvalues : _outputs)
-            qvalues.Resize(n);
+            if (qvalues.IsUsed())
+                qvalues.Resize(n);
 
         for (auto& law : _laws)
             law->Resize(_n);
     }
 
-    Eigen::VectorXd Get(Q what)
+    //! @brief stores the (square) output `what` packed-symmetric, halving
+    //! its memory, see `QValues::SetSymmetric`
+    void SetSymmetric(Q what)
+    {
+        _outputs.at(what).SetSymmetric(true);
+        if (_n != 0)
+            Resize(_n);
+    }
+
+    //! @brief stores the output `what` in float32, halving its memory,
+    //! see `QValues::SetSinglePrecision`
+    void SetSinglePrecision(Q what)
+    {
+        _outputs.at(what).SetSinglePrecision(true);
+        if (_n != 0)
+            Resize(_n);
+    }
+
+    //! @brief returns the output `what` as doubles; a packed-symmetric slot
+    //! is expanded to the full per-IP matrices unless `expand` is false
+    //!
+    //! Blocks on a pending `EvaluateAsync` sweep.
+    Eigen::VectorXd Get(Q what, bool expand = true)
+    {
+        return Get(static_cast<int>(what), expand);
+    }
+
+    //! @brief like `Get(Q)`, but for any registered field name -- predefined
+    //! ("sigma") or law-specific ("void_fraction"), see `QRegistry`
+    Eigen::VectorXd Get(const std::string& name, bool expand = true)
+    {
+        return Get(_registry.Find(name), expand);
+    }
+
+    const QRegistry& Registry() const
+    {
+        return _registry;
+    }
+
+private:
+    Eigen::VectorXd Get(int what, bool expand)
+    {
+        Wait();
+        const QValues& q = _outputs.at(what);
+        if (q.IsSymmetric() and expand)
+        {
+            Eigen::VectorXd expanded(static_cast<long>(_n) * q._rows * q._cols);
+            for (int i = 0; i < _n; ++i)
+                Eigen::Map<Eigen::MatrixXd>(expanded.data() + q._rows * q._cols * i, q._rows, q._cols) =
+                        q.GetSymmetric(i);
+            return _grouped ? Unpermuted(expanded) : expanded;
+        }
+        if (q.IsSinglePrecision())
+            return _grouped ? Unpermuted(q.data_f.cast<double>()) : q.data_f.cast<double>();
+        return _grouped ? Unpermuted(q.data) : q.data;
+    }
+
+public:
+    //! @brief groups the IPs of each law into contiguous storage ranges
+    //!
+    //! For interleaved multi-material meshes the per-law IP lists produce
+    //! scattered accesses that defeat prefetching. Grouped, an IP
+    //! permutation (built by FixIPs, inverse applied in `Get` and
+    //! `EvaluateInto`) sorts the storage by law so every law sweeps one
+    //! dense index range. Enable before the first evaluation; history,
+    //! snapshots and GetF32 then live in the grouped storage order.
+    void SetGrouped(bool grouped = true)
+    {
+        _grouped = grouped;
+    }
+
+    bool IsGrouped() const
+    {
+        return _grouped;
+    }
+
+    //! @brief opt-in instrumentation: wall seconds and sweep counts per law,
+    //! evaluation counts per IP, plus law-specific statistics such as the
+    //! Newton-iteration histogram of MisesPlasticity
+    //!
+    //! Disabled, the only cost is one predicted branch per sweep.
+    void SetInstrumentation(bool enabled)
+    {
+        _instrumented = enabled;
+        ResetStats();
+    }
+
+    //! @brief resets the accumulated statistics, e.g. once per time step
+    void ResetStats()
+    {
+        _law_seconds.assign(_laws.size(), 0.);
+        _law_sweeps.assign(_laws.size(), 0);
+        _ip_evaluations = Eigen::VectorXd::Zero(_n);
+    }
+
+    //! @brief the accumulated statistics, keyed "law<i>/seconds",
+    //! "law<i>/sweeps", "ip_evaluations" plus the law-specific entries
+    std::map<std::string, Eigen::VectorXd> Stats() const
+    {
+        Wait();
+        std::map<std::string, Eigen::VectorXd> stats;
+        for (unsigned iLaw = 0; iLaw < _laws.size(); ++iLaw)
+        {
+            const std::string prefix = "law" + std::to_string(iLaw) + "/";
+            if (iLaw < _law_seconds.size())
+            {
+                stats[prefix + "seconds"] = Eigen::VectorXd::Constant(1, _law_seconds[iLaw]);
+                stats[prefix + "sweeps"] = Eigen::VectorXd::Constant(1, static_cast<double>(_law_sweeps[iLaw]));
+            }
+            for (const auto& entry : _laws[iLaw]->Stats())
+                stats[prefix + entry.first] = entry.second;
+        }
+        stats["ip_evaluations"] = _ip_evaluations;
+        return stats;
+    }
+
+    //! @brief processes the IPs in blocks of `block_size` through small
+    //! staging buffers
+    //!
+    //! Laws writing five output slots per IP interleave five scattered
+    //! streams over multi-megabyte arrays. In the tiled mode each block is
+    //! evaluated into cache-sized staging storage and copied out
+    //! slot-by-slot, so every output array is written in long sequential
+    //! runs. `block_size = 0` disables tiling.
+    void SetBlockSize(int block_size)
+    {
+        _block_size = block_size;
+    }
+
+    //! @brief re-evaluates only IPs whose inputs changed by more than `rtol`
+    //! (relative) since their last evaluation
+    //!
+    //! Near Newton convergence most strain increments are negligible; the
+    //! cached SIGMA/DSIGMA_DEPS and trial history of those IPs are reused.
+    //! The cache is invalidated by `Update`, `Commit` and `Resize`, so the
+    //! first sweep of every step is a full one. `rtol = 0` switches back to
+    //! unconditional full sweeps.
+    void SetIncremental(double rtol)
+    {
+        _incremental_rtol = rtol;
+        _cache_valid = false;
+    }
+
+    //! @brief forces a re-fill of the constant tangents at the next sweep,
+    //! for laws that switch between elastic and inelastic branches
+    void MarkTangentDirty()
+    {
+        _tangent_filled = false;
+    }
+
+    //! @brief sets the time increment input slot for rate-dependent laws,
+    //! uniform over all IPs; call after `Resize` and once per time step
+    void SetDeltaT(double del_t)
+    {
+        FixIPs();
+        if (not _inputs[DEL_T].IsUsed())
+            throw std::runtime_error("No law of this loop defines the DEL_T input!");
+        _inputs[DEL_T].data = Eigen::VectorXd::Constant(_n, del_t);
+    }
+
+    //! @brief the float32 storage of the output `what` without conversion
+    const Eigen::VectorXf& GetF32(Q what)
     {
-        return _outputs.at(what).data;
+        Wait();
+        const QValues& q = _outputs.at(what);
+        if (not q.IsSinglePrecision())
+            throw std::runtime_error("The requested output is not stored in single precision!");
+        return q.data_f;
     }
 
     std::vector<Q> RequiredInputs() const
@@ -253,24 +772,253 @@ public:
         return required;
     }
 
-    virtual void Evaluate(const Eigen::VectorXd& all_strains, const Eigen::VectorXd& all_neeq)
+    virtual void Evaluate(const Eigen::VectorXd& all_strains, const Eigen::VectorXd& all_neeq, int threads = 1)
     {
         FixIPs();
 
-        _inputs[E].data = all_neeq;
-        _inputs[EPS].data = all_strains;
-        for (unsigned iLaw = 0; iLaw < _laws.size(); ++iLaw)
-            for (int ip : _ips[iLaw])
-                _laws[iLaw]->Evaluate(_inputs, _outputs, ip);
+        _inputs[E].data = _grouped ? Permuted(all_neeq) : all_neeq;
+        _inputs[EPS].data = _grouped ? Permuted(all_strains) : all_strains;
+        EvaluateLaws(threads);
+    }
+
+    //! @brief like `Evaluate`, but reads the strains from and writes SIGMA /
+    //! DSIGMA_DEPS into caller-provided memory (e.g. numpy views), instead of
+    //! returning full copies via `Get`
+    void EvaluateInto(Eigen::Ref<const Eigen::VectorXd> all_strains, Eigen::Ref<Eigen::VectorXd> sigma_out,
+                      Eigen::Ref<Eigen::VectorXd> dsigma_out,
+                      Eigen::Ref<const Eigen::VectorXd> all_neeq = Eigen::VectorXd(), int threads = 1)
+    {
+        FixIPs();
+
+        if (_grouped)
+        {
+            _inputs[E].data = Permuted(all_neeq);
+            _inputs[EPS].data = Permuted(all_strains);
+        }
+        else
+        {
+            _inputs[E].data = all_neeq;
+            _inputs[EPS].data = all_strains;
+        }
+        EvaluateLaws(threads);
+
+        if (sigma_out.size() != _outputs[SIGMA].data.size() or
+            dsigma_out.size() != _outputs[DSIGMA_DEPS].data.size())
+            throw std::runtime_error("The output buffer sizes don't match the storage layout!");
+        sigma_out = _grouped ? Unpermuted(_outputs[SIGMA].data) : _outputs[SIGMA].data;
+        dsigma_out = _grouped ? Unpermuted(_outputs[DSIGMA_DEPS].data) : _outputs[DSIGMA_DEPS].data;
+    }
+
+    //! @brief starts the `Evaluate` sweep on a background thread and returns
+    //! immediately, so e.g. symbolic assembly setup, boundary conditions and
+    //! preconditioner decisions can overlap the constitutive update
+    //!
+    //! All output slots of a sweep complete together; `Get` (and `Wait`)
+    //! block until then. Exceptions of the sweep are rethrown there.
+    void EvaluateAsync(const Eigen::VectorXd& all_strains, const Eigen::VectorXd& all_neeq, int threads = 1)
+    {
+        Wait();
+        FixIPs(); // setup and validation errors surface on the calling thread
+        _async = std::async(std::launch::async, [this, all_strains, all_neeq, threads]() {
+            Evaluate(all_strains, all_neeq, threads);
+        });
     }
 
-    virtual void Update(const Eigen::VectorXd& all_strains, const Eigen::VectorXd& all_neeq)
+    //! @brief blocks until the pending `EvaluateAsync` sweep (if any) has
+    //! finished and rethrows its exceptions
+    //!
+    //! Const (on the mutable future) so that read-only consumers like the
+    //! fused assembly and `Stats` can synchronize too.
+    void Wait() const
     {
-        _inputs[E].data = all_neeq;
-        _inputs[EPS].data = all_strains;
+        if (_async.valid())
+            _async.get();
+    }
+
+    virtual void Update(const Eigen::VectorXd& all_strains, const Eigen::VectorXd& all_neeq, int threads = 1)
+    {
+        Wait();
+        FixIPs(); // like Evaluate, so Update may be the first sweep of a loop
+        _cache_valid = false;
+        _inputs[E].data = _grouped ? Permuted(all_neeq) : all_neeq;
+        _inputs[EPS].data = _grouped ? Permuted(all_strains) : all_strains;
+        ValidateInputs();
         for (unsigned iLaw = 0; iLaw < _laws.size(); ++iLaw)
-            for (int ip : _ips[iLaw])
-                _laws[iLaw]->Update(_inputs, ip);
+        {
+            if (threads <= 1)
+            {
+                _laws[iLaw]->UpdateAll(_inputs, _ips[iLaw]);
+                continue;
+            }
+
+            const auto chunks = Chunks(_ips[iLaw], threads);
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(threads) schedule(static)
+#endif
+            for (int iChunk = 0; iChunk < static_cast<int>(chunks.size()); ++iChunk)
+                _laws[iLaw]->UpdateAll(_inputs, chunks[iChunk]);
+        }
+    }
+
+    //! @brief commits the trial history of the last `Evaluate`
+    //!
+    //! Use this instead of `Update` when `Evaluate` was already called with
+    //! the converged strains -- it skips the second full sweep over all IPs.
+    void Commit()
+    {
+        Wait();
+        _cache_valid = false;
+        for (auto& law : _laws)
+            law->Commit();
+    }
+
+    //! @brief writes the committed history of all laws to `path` as one flat
+    //! binary snapshot: magic + version + field table, then the raw double
+    //! arrays
+    void SaveState(const std::string& path)
+    {
+        Wait();
+        auto fields = HistoryFields();
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        if (not file)
+            throw std::runtime_error("Cannot open '" + path + "' for writing!");
+
+        file.write("CONSTHIS", 8);
+        WriteU64(file, 1); // format version
+        WriteU64(file, fields.size());
+        for (const auto& field : fields)
+        {
+            WriteU64(file, field.first.size());
+            file.write(field.first.data(), field.first.size());
+            WriteU64(file, field.second->data.size());
+        }
+        for (const auto& field : fields)
+            file.write(reinterpret_cast<const char*>(field.second->data.data()),
+                       field.second->data.size() * sizeof(double));
+        if (not file)
+            throw std::runtime_error("Writing the state to '" + path + "' failed!");
+    }
+
+    //! @brief restores a `SaveState` snapshot via a read-only mapping, so
+    //! multi-gigabyte restarts stream at device speed
+    //!
+    //! The laws and their `Resize` must match the saved configuration --
+    //! names and sizes of all history fields are validated.
+    void LoadState(const std::string& path)
+    {
+        auto fields = HistoryFields();
+
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd == -1)
+            throw std::runtime_error("Cannot open '" + path + "' for reading!");
+        struct stat st;
+        ::fstat(fd, &st);
+        const std::size_t size = st.st_size;
+        void* mapping = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (mapping == MAP_FAILED)
+            throw std::runtime_error("Cannot map '" + path + "'!");
+
+        try
+        {
+            const char* p = static_cast<const char*>(mapping);
+            const char* end = p + size;
+            Require(end - p >= 8 and std::memcmp(p, "CONSTHIS", 8) == 0, "not a state snapshot");
+            p += 8;
+            Require(ReadU64(p, end) == 1, "unknown snapshot version");
+            Require(ReadU64(p, end) == fields.size(), "field count mismatch");
+            for (const auto& field : fields)
+            {
+                const std::uint64_t name_length = ReadU64(p, end);
+                Require(end - p >= static_cast<std::ptrdiff_t>(name_length), "truncated field table");
+                Require(std::string(p, p + name_length) == field.first, "field name mismatch");
+                p += name_length;
+                Require(ReadU64(p, end) == static_cast<std::uint64_t>(field.second->data.size()),
+                        "size mismatch in " + field.first);
+            }
+            for (const auto& field : fields)
+            {
+                const std::size_t bytes = field.second->data.size() * sizeof(double);
+                Require(end - p >= static_cast<std::ptrdiff_t>(bytes), "truncated field data");
+                std::memcpy(field.second->data.data(), p, bytes);
+                p += bytes;
+            }
+        }
+        catch (...)
+        {
+            ::munmap(mapping, size);
+            throw;
+        }
+        ::munmap(mapping, size);
+        _cache_valid = false;
+    }
+
+    //! @brief transfers the committed history from `old_loop` on a remesh
+    //!
+    //! `old_coords` / `new_coords` hold one IP coordinate per row (1D--3D),
+    //! indexed by global IP number of the respective loop. Each new IP
+    //! receives the history of its nearest old IP; the donors are found
+    //! through a uniform cell grid built over the old coordinates, so the
+    //! whole transfer is O(n) instead of the O(n^2) brute-force pairing.
+    //! All registered history `QValues` (validated to match by name and
+    //! per-IP size) are remapped in one parallel batched pass.
+    //!
+    //! Call on the already `Resize`d new loop with matching laws; the laws
+    //! see the transferred values as their committed state.
+    void TransferFrom(IpLoop& old_loop, const Eigen::MatrixXd& old_coords, const Eigen::MatrixXd& new_coords,
+                      int threads = 1)
+    {
+        Wait();
+        old_loop.Wait();
+        FixIPs();
+        old_loop.FixIPs();
+
+        if (old_coords.rows() != old_loop._n or new_coords.rows() != _n)
+            throw std::runtime_error("The coordinate row counts don't match the loop sizes!");
+        if (old_coords.cols() != new_coords.cols() or old_coords.cols() < 1 or old_coords.cols() > 3)
+            throw std::runtime_error("The IP coordinates must share one spatial dimension (1D-3D)!");
+        if (old_loop._n == 0)
+            throw std::runtime_error("Cannot transfer from an empty loop!");
+
+        auto fields = HistoryFields();
+        auto old_fields = old_loop.HistoryFields();
+        if (fields.size() != old_fields.size())
+            throw std::runtime_error("The history field counts don't match!");
+        for (unsigned iField = 0; iField < fields.size(); ++iField)
+        {
+            if (fields[iField].first != old_fields[iField].first)
+                throw std::runtime_error("History field name mismatch in " + fields[iField].first + "!");
+            if (fields[iField].second->ValuesPerIp() != old_fields[iField].second->ValuesPerIp() or
+                fields[iField].second->IsSinglePrecision() != old_fields[iField].second->IsSinglePrecision())
+                throw std::runtime_error("History field layout mismatch in " + fields[iField].first + "!");
+        }
+
+        // donors in global IP numbers ...
+        const std::vector<int> donors = NearestDonors(old_coords, new_coords, threads);
+
+        // ... mapped to the storage order of the two loops
+        std::vector<int> old_storage(old_loop._n);
+        for (int s = 0; s < old_loop._n; ++s)
+            old_storage[old_loop._grouped ? old_loop._perm[s] : s] = s;
+
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(threads) schedule(static) if (threads > 1)
+#endif
+        for (int s = 0; s < _n; ++s)
+        {
+            const int donor = old_storage[donors[_grouped ? _perm[s] : s]];
+            for (unsigned iField = 0; iField < fields.size(); ++iField)
+            {
+                const int values_per_ip = fields[iField].second->ValuesPerIp();
+                if (fields[iField].second->IsSinglePrecision())
+                    fields[iField].second->data_f.segment(values_per_ip * s, values_per_ip) =
+                            old_fields[iField].second->data_f.segment(values_per_ip * donor, values_per_ip);
+                else
+                    fields[iField].second->data.segment(values_per_ip * s, values_per_ip) =
+                            old_fields[iField].second->data.segment(values_per_ip * donor, values_per_ip);
+            }
+        }
+        _cache_valid = false;
     }
 
     std::vector<std::shared_ptr<LawInterface>> _laws;
@@ -279,7 +1027,360 @@ public:
     std::vector<QValues> _inputs;
     int _n = 0;
 
+    //! @brief history fields of all laws, law index prefixed for uniqueness
+    std::vector<std::pair<std::string, QValues*>> HistoryFields()
+    {
+        std::vector<std::pair<std::string, QValues*>> fields;
+        for (unsigned iLaw = 0; iLaw < _laws.size(); ++iLaw)
+            for (const auto& field : _laws[iLaw]->HistoryFields())
+                fields.emplace_back("law" + std::to_string(iLaw) + "/" + field.first, field.second);
+        return fields;
+    }
+
 private:
+    //! @brief every used input slot must be filled for all IPs before a
+    //! sweep -- a DEL_T-consuming law without `SetDeltaT` (or a nonlocal law
+    //! fed an empty field) would otherwise read the empty array
+    void ValidateInputs() const
+    {
+        for (unsigned iQ = 0; iQ < _inputs.size(); ++iQ)
+            if (_inputs[iQ].IsUsed() and
+                _inputs[iQ].data.size() != static_cast<long>(_n) * _inputs[iQ].ValuesPerIp())
+                throw std::runtime_error("The input '" + _registry.Name(iQ) +
+                                         "' is not set for all IPs -- e.g. a rate-dependent law needs SetDeltaT "
+                                         "once per step!");
+    }
+
+    void EvaluateLaws(int threads)
+    {
+        ValidateInputs();
+        if (not _tangent_filled)
+        {
+            for (unsigned iLaw = 0; iLaw < _laws.size(); ++iLaw)
+            {
+                Eigen::MatrixXd tangent;
+                if (_laws[iLaw]->ConstantTangent(tangent))
+                    for (int ip : _ips[iLaw])
+                        _outputs[DSIGMA_DEPS].Set(tangent, ip);
+            }
+            _tangent_filled = true;
+        }
+
+        const bool incremental = _incremental_rtol > 0 and _cache_valid and
+                                 _eps_cache.size() == _inputs[EPS].data.size() and
+                                 _e_cache.size() == _inputs[E].data.size();
+
+        if (_instrumented and (_law_seconds.size() != _laws.size() or _ip_evaluations.size() != _n))
+            ResetStats();
+
+        for (unsigned iLaw = 0; iLaw < _laws.size(); ++iLaw)
+        {
+            std::vector<int> dirty;
+            if (incremental)
+                dirty = DirtyIps(_ips[iLaw]);
+            const std::vector<int>& ips = incremental ? dirty : _ips[iLaw];
+
+            std::chrono::steady_clock::time_point t_start;
+            if (_instrumented)
+                t_start = std::chrono::steady_clock::now();
+
+            if (_block_size > 0)
+            {
+                EvaluateTiled(*_laws[iLaw], ips, threads);
+            }
+            else if (threads <= 1)
+            {
+                _laws[iLaw]->EvaluateAll(_inputs, _outputs, ips);
+            }
+            else
+            {
+                // Each IP writes to disjoint slices of _outputs, so the
+                // chunks can be evaluated concurrently without
+                // synchronization.
+                const auto chunks = Chunks(ips, threads);
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(threads) schedule(static)
+#endif
+                for (int iChunk = 0; iChunk < static_cast<int>(chunks.size()); ++iChunk)
+                    _laws[iLaw]->EvaluateAll(_inputs, _outputs, chunks[iChunk]);
+            }
+
+            if (_instrumented)
+            {
+                _law_seconds[iLaw] += std::chrono::duration<double>(std::chrono::steady_clock::now() - t_start).count();
+                _law_sweeps[iLaw] += 1;
+                for (int ip : ips)
+                    _ip_evaluations[ip] += 1.;
+            }
+
+            if (_incremental_rtol > 0)
+                CacheInputs(ips, incremental);
+        }
+    }
+
+    //! @brief block-wise evaluation through staging buffers, see SetBlockSize
+    void EvaluateTiled(LawInterface& law, const std::vector<int>& ips, int threads)
+    {
+        Eigen::MatrixXd unused;
+        const bool constant_tangent = law.ConstantTangent(unused);
+        const int n_ips = ips.size();
+        const int n_blocks = (n_ips + _block_size - 1) / _block_size;
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(threads) schedule(static) if (threads > 1)
+#endif
+        for (int iBlock = 0; iBlock < n_blocks; ++iBlock)
+        {
+            const int begin = iBlock * _block_size;
+            const int end = std::min(begin + _block_size, n_ips);
+            const std::vector<int> block(ips.begin() + begin, ips.begin() + end);
+
+            // staging requires a contiguous IP run -- evaluate gaps directly
+            if (not IsContiguousRun(block))
+            {
+                law.EvaluateAll(_inputs, _outputs, block);
+                continue;
+            }
+
+            std::vector<QValues> staging(_outputs.size());
+            for (unsigned iQ = 0; iQ < _outputs.size(); ++iQ)
+            {
+                if (not _outputs[iQ].IsUsed())
+                    continue;
+                staging[iQ] = QValues(_outputs[iQ]._rows, _outputs[iQ]._cols);
+                staging[iQ].SetSymmetric(_outputs[iQ].IsSymmetric());
+                staging[iQ].SetSinglePrecision(_outputs[iQ].IsSinglePrecision());
+                staging[iQ].SetOffset(block.front());
+                staging[iQ].Resize(block.size());
+
+                // seed from the destination: a law may skip some writes, e.g.
+                // the prescreen fast path keeps the stored EEQ/DEEQ of
+                // screened IPs, and the copy-out must not zero them
+                if (constant_tangent and iQ == DSIGMA_DEPS)
+                    continue;
+                const int values_per_ip = _outputs[iQ].ValuesPerIp();
+                if (staging[iQ].IsSinglePrecision())
+                    staging[iQ].data_f =
+                            _outputs[iQ].data_f.segment(block.front() * values_per_ip, block.size() * values_per_ip);
+                else
+                    staging[iQ].data =
+                            _outputs[iQ].data.segment(block.front() * values_per_ip, block.size() * values_per_ip);
+            }
+
+            law.EvaluateAll(_inputs, staging, block);
+
+            // copy out slot-by-slot: one long sequential write per array
+            for (unsigned iQ = 0; iQ < _outputs.size(); ++iQ)
+            {
+                if (not _outputs[iQ].IsUsed())
+                    continue;
+                // the staging buffer of a constant tangent was never written
+                if (constant_tangent and iQ == DSIGMA_DEPS)
+                    continue;
+                const int values_per_ip = _outputs[iQ].ValuesPerIp();
+                if (_outputs[iQ].IsSinglePrecision())
+                    _outputs[iQ].data_f.segment(block.front() * values_per_ip, block.size() * values_per_ip) =
+                            staging[iQ].data_f;
+                else
+                    _outputs[iQ].data.segment(block.front() * values_per_ip, block.size() * values_per_ip) =
+                            staging[iQ].data;
+            }
+        }
+    }
+
+    static bool IsContiguousRun(const std::vector<int>& ips)
+    {
+        for (unsigned k = 0; k + 1 < ips.size(); ++k)
+            if (ips[k + 1] != ips[k] + 1)
+                return false;
+        return not ips.empty();
+    }
+
+    //! @brief IPs of `ips` whose EPS (and, if used, E) input moved by more
+    //! than the relative tolerance since their last evaluation
+    std::vector<int> DirtyIps(const std::vector<int>& ips) const
+    {
+        const bool with_e = _inputs[E].IsUsed() and _inputs[E].data.size() > 0;
+        const int q = _inputs[EPS]._rows;
+        std::vector<int> dirty;
+        for (int ip : ips)
+        {
+            const auto eps = _inputs[EPS].data.segment(q * ip, q);
+            bool changed = (eps - _eps_cache.segment(q * ip, q)).norm() > _incremental_rtol * (eps.norm() + 1.e-30);
+            if (not changed and with_e)
+            {
+                const double e = _inputs[E].data[ip];
+                changed = std::abs(e - _e_cache[ip]) > _incremental_rtol * (std::abs(e) + 1.e-30);
+            }
+            if (changed)
+                dirty.push_back(ip);
+        }
+        return dirty;
+    }
+
+    //! @brief stores the just-evaluated inputs as the new cache reference
+    void CacheInputs(const std::vector<int>& evaluated, bool incremental)
+    {
+        if (not incremental)
+        {
+            _eps_cache = _inputs[EPS].data;
+            _e_cache = _inputs[E].data;
+            _cache_valid = true;
+            return;
+        }
+        const int q = _inputs[EPS]._rows;
+        for (int ip : evaluated)
+        {
+            _eps_cache.segment(q * ip, q) = _inputs[EPS].data.segment(q * ip, q);
+            if (_e_cache.size() > 0)
+                _e_cache[ip] = _inputs[E].data[ip];
+        }
+    }
+
+    QRegistry _registry;
+    int _block_size = 0;
+    bool _tangent_filled = false;
+    mutable std::future<void> _async;
+    bool _grouped = false;
+    std::vector<int> _perm;
+    std::vector<std::vector<int>> _global_ips;
+    bool _instrumented = false;
+    std::vector<double> _law_seconds;
+    std::vector<long> _law_sweeps;
+    Eigen::VectorXd _ip_evaluations;
+    double _incremental_rtol = 0.;
+    bool _cache_valid = false;
+    Eigen::VectorXd _eps_cache;
+    Eigen::VectorXd _e_cache;
+
+    static void WriteU64(std::ofstream& file, std::uint64_t value)
+    {
+        file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+
+    static std::uint64_t ReadU64(const char*& p, const char* end)
+    {
+        Require(end - p >= static_cast<std::ptrdiff_t>(sizeof(std::uint64_t)), "truncated header");
+        std::uint64_t value;
+        std::memcpy(&value, p, sizeof(value));
+        p += sizeof(value);
+        return value;
+    }
+
+    static void Require(bool condition, const std::string& what)
+    {
+        if (not condition)
+            throw std::runtime_error("Invalid state snapshot: " + what + "!");
+    }
+
+    //! @brief nearest old IP for every new IP via a uniform cell grid over
+    //! the old coordinates, ring-expanded per query until the nearest bucket
+    //! cannot be beaten anymore
+    static std::vector<int> NearestDonors(const Eigen::MatrixXd& old_coords, const Eigen::MatrixXd& new_coords,
+                                          int threads)
+    {
+        const int n_old = old_coords.rows();
+        const int dim = old_coords.cols();
+
+        // padded to 3D with single-cell dummy dimensions, so one code path
+        // serves 1D-3D
+        Eigen::Vector3d lower = Eigen::Vector3d::Zero();
+        Eigen::Vector3d width = Eigen::Vector3d::Ones();
+        Eigen::Vector3i cells = Eigen::Vector3i::Ones();
+        const int cells_per_dim = std::max(1, static_cast<int>(std::floor(std::pow(n_old, 1. / dim))));
+        for (int d = 0; d < dim; ++d)
+        {
+            lower[d] = old_coords.col(d).minCoeff();
+            const double extent = old_coords.col(d).maxCoeff() - lower[d];
+            cells[d] = extent > 0. ? cells_per_dim : 1;
+            width[d] = std::max(extent, 1.e-30) / cells[d];
+        }
+
+        auto cellOf = [&](const Eigen::MatrixXd& coords, int i, int d) {
+            if (d >= dim)
+                return 0;
+            const int c = static_cast<int>((coords(i, d) - lower[d]) / width[d]);
+            return std::min(std::max(c, 0), cells[d] - 1);
+        };
+        auto flatten = [&](int cx, int cy, int cz) { return (cz * cells[1] + cy) * cells[0] + cx; };
+
+        // bucket the old IPs into the grid (counting sort layout)
+        const int n_cells = cells[0] * cells[1] * cells[2];
+        std::vector<int> offsets(n_cells + 1, 0);
+        for (int i = 0; i < n_old; ++i)
+            ++offsets[flatten(cellOf(old_coords, i, 0), cellOf(old_coords, i, 1), cellOf(old_coords, i, 2)) + 1];
+        for (int c = 0; c < n_cells; ++c)
+            offsets[c + 1] += offsets[c];
+        std::vector<int> buckets(n_old);
+        std::vector<int> fill(offsets.begin(), offsets.end() - 1);
+        for (int i = 0; i < n_old; ++i)
+            buckets[fill[flatten(cellOf(old_coords, i, 0), cellOf(old_coords, i, 1), cellOf(old_coords, i, 2))]++] = i;
+
+        const double min_width = width.head(dim).minCoeff();
+        const int max_ring = cells.maxCoeff();
+
+        std::vector<int> donors(new_coords.rows());
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(threads) schedule(static) if (threads > 1)
+#endif
+        for (int i = 0; i < static_cast<int>(new_coords.rows()); ++i)
+        {
+            Eigen::Vector3d x = Eigen::Vector3d::Zero();
+            for (int d = 0; d < dim; ++d)
+                x[d] = new_coords(i, d);
+            const int hx = cellOf(new_coords, i, 0);
+            const int hy = cellOf(new_coords, i, 1);
+            const int hz = cellOf(new_coords, i, 2);
+
+            int best = -1;
+            double best_d2 = std::numeric_limits<double>::max();
+            for (int ring = 0; ring <= max_ring; ++ring)
+            {
+                // every unvisited cell (Chebyshev cell distance >= ring) is
+                // at least (ring - 1) cell widths from the query point
+                const double reach = (ring - 1) * min_width;
+                if (best != -1 and ring >= 1 and best_d2 <= reach * reach)
+                    break;
+
+                for (int cz = std::max(hz - ring, 0); cz <= std::min(hz + ring, cells[2] - 1); ++cz)
+                    for (int cy = std::max(hy - ring, 0); cy <= std::min(hy + ring, cells[1] - 1); ++cy)
+                        for (int cx = std::max(hx - ring, 0); cx <= std::min(hx + ring, cells[0] - 1); ++cx)
+                        {
+                            // only the outer shell of this ring is new
+                            if (std::max({std::abs(cx - hx), std::abs(cy - hy), std::abs(cz - hz)}) != ring)
+                                continue;
+                            const int cell = flatten(cx, cy, cz);
+                            for (int k = offsets[cell]; k < offsets[cell + 1]; ++k)
+                            {
+                                const int j = buckets[k];
+                                double d2 = 0.;
+                                for (int d = 0; d < dim; ++d)
+                                    d2 += (old_coords(j, d) - x[d]) * (old_coords(j, d) - x[d]);
+                                if (d2 < best_d2)
+                                {
+                                    best_d2 = d2;
+                                    best = j;
+                                }
+                            }
+                        }
+            }
+            donors[i] = best;
+        }
+        return donors;
+    }
+
+    static std::vector<std::vector<int>> Chunks(const std::vector<int>& ips, int threads)
+    {
+        const int n = ips.size();
+        const int chunk_size = (n + threads - 1) / threads;
+        std::vector<std::vector<int>> chunks;
+        for (int start = 0; start < n; start += chunk_size)
+        {
+            const int end = std::min(start + chunk_size, n);
+            chunks.emplace_back(ips.begin() + start, ips.begin() + end);
+        }
+        return chunks;
+    }
+
     void FixIPs()
     {
         // Actually, there is only one case to fix:
@@ -316,6 +1417,56 @@ private:
                 throw std::runtime_error("Ip has no law!");
             }
         }
+
+        if (_grouped and _perm.empty())
+            BuildGroups();
+    }
+
+    //! @brief storage order = laws concatenated; afterwards each law's IP
+    //! list is its dense storage range and `_perm` maps storage -> global IP
+    void BuildGroups()
+    {
+        _global_ips = _ips; // kept for re-grouping after a Resize
+        _perm.reserve(_n);
+        for (auto& ips : _ips)
+        {
+            std::sort(ips.begin(), ips.end());
+            for (int ip : ips)
+                _perm.push_back(ip);
+        }
+
+        int offset = 0;
+        for (auto& ips : _ips)
+        {
+            std::iota(ips.begin(), ips.end(), offset);
+            offset += ips.size();
+        }
+    }
+
+    //! @brief reorders a per-IP field from global to storage order
+    Eigen::VectorXd Permuted(Eigen::Ref<const Eigen::VectorXd> field) const
+    {
+        if (field.size() == 0 or _n == 0)
+            return field;
+        const int values_per_ip = field.size() / _n;
+        Eigen::VectorXd permuted(field.size());
+        for (int s = 0; s < _n; ++s)
+            permuted.segment(values_per_ip * s, values_per_ip) =
+                    field.segment(values_per_ip * _perm[s], values_per_ip);
+        return permuted;
+    }
+
+    //! @brief reorders a per-IP field from storage back to global order
+    Eigen::VectorXd Unpermuted(const Eigen::VectorXd& field) const
+    {
+        if (field.size() == 0 or _n == 0)
+            return field;
+        const int values_per_ip = field.size() / _n;
+        Eigen::VectorXd unpermuted(field.size());
+        for (int s = 0; s < _n; ++s)
+            unpermuted.segment(values_per_ip * _perm[s], values_per_ip) =
+                    field.segment(values_per_ip * s, values_per_ip);
+        return unpermuted;
     }
 };
 
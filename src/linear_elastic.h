@@ -5,19 +5,19 @@ template <Constraint TC>
 M<TC> C(double E, double nu);
 
 template <>
-M<UNIAXIAL_STRAIN> C<UNIAXIAL_STRAIN>(double E, double nu)
+inline M<UNIAXIAL_STRAIN> C<UNIAXIAL_STRAIN>(double E, double nu)
 {
     return M<UNIAXIAL_STRAIN>::Constant(E);
 }
 
 template <>
-M<UNIAXIAL_STRESS> C<UNIAXIAL_STRESS>(double E, double nu)
+inline M<UNIAXIAL_STRESS> C<UNIAXIAL_STRESS>(double E, double nu)
 {
     return M<UNIAXIAL_STRAIN>::Constant(E);
 }
 
 template <>
-M<PLANE_STRESS> C<PLANE_STRESS>(double E, double nu)
+inline M<PLANE_STRESS> C<PLANE_STRESS>(double E, double nu)
 {
     const double C11 = E / (1 - nu * nu);
     const double C12 = nu * C11;
@@ -28,7 +28,7 @@ M<PLANE_STRESS> C<PLANE_STRESS>(double E, double nu)
 }
 
 template <>
-M<PLANE_STRAIN> C<PLANE_STRAIN>(double E, double nu)
+inline M<PLANE_STRAIN> C<PLANE_STRAIN>(double E, double nu)
 {
     const double l = E * nu / (1 + nu) / (1 - 2 * nu);
     const double m = E / (2.0 * (1 + nu));
@@ -38,7 +38,7 @@ M<PLANE_STRAIN> C<PLANE_STRAIN>(double E, double nu)
 }
 
 template <>
-M<FULL> C<FULL>(double E, double nu)
+inline M<FULL> C<FULL>(double E, double nu)
 {
     const double l = E * nu / (1 + nu) / (1 - 2 * nu);
     const double m = E / (2.0 * (1 + nu));
@@ -51,7 +51,7 @@ M<FULL> C<FULL>(double E, double nu)
     return c;
 }
 
-Eigen::MatrixXd C(double E, double nu, Constraint c)
+inline Eigen::MatrixXd C(double E, double nu, Constraint c)
 {
     if (c == UNIAXIAL_STRAIN)
         return C<UNIAXIAL_STRAIN>(E, nu);
@@ -80,7 +80,60 @@ public:
         return {_C * strain, _C};
     }
 
+    bool ConstantTangent(Eigen::MatrixXd& tangent) const override
+    {
+        tangent = _C;
+        return true;
+    }
+
 private:
     Eigen::MatrixXd _C;
 };
 
+//! @brief constraint-specialized LinearElastic working entirely in fixed-size
+//! types, so Eigen can unroll the q x q products
+template <Constraint TC>
+class LinearElasticT : public LawInterface
+{
+public:
+    static constexpr int q = Dim::Q(TC);
+
+    LinearElasticT(double E, double nu)
+        : _C(C<TC>(E, nu))
+    {
+    }
+
+    void DefineOutputs(std::vector<QValues>& out) const override
+    {
+        out[SIGMA] = QValues(q);
+        out[DSIGMA_DEPS] = QValues(q, q);
+    }
+
+    void DefineInputs(std::vector<QValues>& input) const override
+    {
+        input[EPS] = QValues(q);
+    }
+
+    void Evaluate(const std::vector<QValues>& input, std::vector<QValues>& out, int i) override
+    {
+        out[SIGMA].GetMap<q, 1>(i) = _C * input[EPS].GetMap<q, 1>(i);
+        out[DSIGMA_DEPS].GetMap<q, q>(i) = _C;
+    }
+
+    void EvaluateAll(const std::vector<QValues>& input, std::vector<QValues>& out, const std::vector<int>& ips) override
+    {
+        // DSIGMA_DEPS is constant and pre-filled by the IpLoop
+        for (int ip : ips)
+            out[SIGMA].GetMap<q, 1>(ip) = _C * input[EPS].GetMap<q, 1>(ip);
+    }
+
+    bool ConstantTangent(Eigen::MatrixXd& tangent) const override
+    {
+        tangent = _C;
+        return true;
+    }
+
+private:
+    const M<TC> _C;
+};
+
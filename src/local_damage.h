@@ -5,11 +5,40 @@
 struct DamageLawInterface
 {
     virtual std::pair<double, double> Evaluate(double kappa) const = 0;
+
+    //! @brief threshold below which the law is guaranteed damage-free;
+    //! 0 disables the elastic-prescreen fast path
+    virtual double Kappa0() const
+    {
+        return 0.;
+    }
 };
 
 struct StrainNormInterface
 {
-    virtual std::pair<double, Eigen::VectorXd> Evaluate(Eigen::VectorXd strain) const = 0;
+    virtual std::pair<double, Eigen::VectorXd> Evaluate(const Eigen::VectorXd& strain) const = 0;
+
+    //! @brief like `Evaluate`, but writes the derivative into a caller
+    //! provided buffer; override this allocation-free in derived norms
+    virtual double EvaluateInto(Eigen::Ref<const Eigen::VectorXd> strain, Eigen::Ref<Eigen::VectorXd> deeq) const
+    {
+        auto eval = Evaluate(strain);
+        deeq = eval.second;
+        return eval.first;
+    }
+
+    //! @brief batched variant over a contiguous block of `n` IP strains with
+    //! `q` components each
+    //!
+    //! This is the inner loop of every damage run. The base implementation
+    //! loops `EvaluateInto`; norms should override it with a fixed-size
+    //! kernel the compiler can vectorize.
+    virtual void EvaluateBlock(const double* strains, double* eeq, double* deeq, int q, int n) const
+    {
+        for (int i = 0; i < n; ++i)
+            eeq[i] = EvaluateInto(Eigen::Map<const Eigen::VectorXd>(strains + i * q, q),
+                                  Eigen::Map<Eigen::VectorXd>(deeq + i * q, q));
+    }
 };
 
 class DamageLawExponential : public DamageLawInterface
@@ -31,13 +60,18 @@ public:
         return {omega, domega};
     }
 
+    double Kappa0() const override
+    {
+        return _k0;
+    }
+
 private:
     const double _k0;
     const double _a;
     const double _b;
 };
 
-std::pair<double, V<FULL>> InvariantI1(V<FULL> v)
+inline std::pair<double, V<FULL>> InvariantI1(V<FULL> v)
 {
     const double I1 = v[0] + v[1] + v[2];
     V<FULL> dI1 = V<FULL>::Zero();
@@ -45,7 +79,7 @@ std::pair<double, V<FULL>> InvariantI1(V<FULL> v)
     return {I1, dI1};
 }
 
-std::pair<double, V<FULL>> InvariantJ2(V<FULL> v)
+inline std::pair<double, V<FULL>> InvariantJ2(V<FULL> v)
 {
     const double J2 =
             ((v[0] - v[1]) * (v[0] - v[1]) + (v[1] - v[2]) * (v[1] - v[2]) + (v[2] - v[0]) * (v[2] - v[0])) / 6. +
@@ -60,7 +94,7 @@ std::pair<double, V<FULL>> InvariantJ2(V<FULL> v)
     return {J2, dJ2};
 }
 
-Eigen::Matrix<double, 6, Eigen::Dynamic> T3D(double nu, Constraint c)
+inline Eigen::Matrix<double, 6, Eigen::Dynamic> T3D(double nu, Constraint c)
 {
     Eigen::Matrix<double, 6, Eigen::Dynamic> T(6, Dim::Q(c));
     T.setZero();
@@ -115,7 +149,14 @@ public:
     {
     }
 
-    std::pair<double, Eigen::VectorXd> Evaluate(Eigen::VectorXd strain) const
+    std::pair<double, Eigen::VectorXd> Evaluate(const Eigen::VectorXd& strain) const override
+    {
+        Eigen::VectorXd deeq(strain.rows());
+        const double eeq = EvaluateInto(strain, deeq);
+        return {eeq, deeq};
+    }
+
+    double EvaluateInto(Eigen::Ref<const Eigen::VectorXd> strain, Eigen::Ref<Eigen::VectorXd> deeq) const override
     {
         // transformation to 3D and invariants
         const V<FULL> strain3D = _T3D * strain;
@@ -129,13 +170,52 @@ public:
         const double eeq = _K1 * I1 + A;
         const double deeq_dI1 = _K1 + _K1 * _K1 * I1 / A;
         const double deeq_dJ2 = _K2 / (2 * A);
-        //
-        //// derivative in 3D and transformation back
-        V<FULL> deeq = deeq_dI1 * dI1 + deeq_dJ2 * dJ2;
-        return {eeq, _T3D.transpose() * deeq};
+
+        // derivative in 3D and transformation back
+        const V<FULL> deeq3D = deeq_dI1 * dI1 + deeq_dJ2 * dJ2;
+        deeq.noalias() = _T3D.transpose() * deeq3D;
+        return eeq;
+    }
+
+    void EvaluateBlock(const double* strains, double* eeq, double* deeq, int q, int n) const override
+    {
+        assert(q == _T3D.cols());
+        if (q == 1)
+            EvaluateBlockImpl<1>(strains, eeq, deeq, n);
+        else if (q == 3)
+            EvaluateBlockImpl<3>(strains, eeq, deeq, n);
+        else
+            EvaluateBlockImpl<6>(strains, eeq, deeq, n);
     }
 
 private:
+    //! @brief fixed-size norm kernel: the transformations are hoisted out of
+    //! the loop and no dynamic temporaries remain inside, so the compiler
+    //! can keep the per-IP math in registers and vectorize it
+    template <int TQ>
+    void EvaluateBlockImpl(const double* strains, double* eeq, double* deeq, int n) const
+    {
+        const Eigen::Matrix<double, 6, TQ> T = _T3D;
+        const Eigen::Matrix<double, TQ, 6> Tt = _T3D.transpose();
+        for (int i = 0; i < n; ++i)
+        {
+            const Eigen::Map<const Eigen::Matrix<double, TQ, 1>> strain(strains + i * TQ);
+            const V<FULL> strain3D = T * strain;
+            double I1, J2;
+            V<FULL> dI1, dJ2;
+            std::tie(I1, dI1) = InvariantI1(strain3D);
+            std::tie(J2, dJ2) = InvariantJ2(strain3D);
+
+            const double A = std::sqrt(_K1 * _K1 * I1 * I1 + _K2 * J2) + 1.e-14;
+            eeq[i] = _K1 * I1 + A;
+            const double deeq_dI1 = _K1 + _K1 * _K1 * I1 / A;
+            const double deeq_dJ2 = _K2 / (2 * A);
+
+            const V<FULL> deeq3D = deeq_dI1 * dI1 + deeq_dJ2 * dJ2;
+            Eigen::Map<Eigen::Matrix<double, TQ, 1>>(deeq + i * TQ).noalias() = Tt * deeq3D;
+        }
+    }
+
     const double _K1;
     const double _K2;
     const double _nu;
@@ -154,22 +234,44 @@ public:
         , _omega(omega)
         , _strain_norm(strain_norm)
         , _kappa(1)
+        , _kappa_trial(1)
     {
     }
 
     void Resize(int n) override
     {
         _kappa.Resize(n);
+        _kappa_trial.Resize(n);
+        _active.assign(n, true);
     }
 
-    std::pair<Eigen::VectorXd, Eigen::MatrixXd> Evaluate(const Eigen::VectorXd& strain, int i) override
+    //! @brief opt-in fast path that evaluates IPs screened as elastic in the
+    //! last `Update` via the undamaged `_C` without the strain norm
+    void SetPrescreen(bool prescreen)
     {
-        double kappa, dkappa, omega, domega, eeq;
-        Eigen::VectorXd deeq;
+        _prescreen = prescreen;
+        _active.assign(_kappa.data.size(), true);
+    }
 
-        std::tie(eeq, deeq) = _strain_norm->Evaluate(strain);
+    std::pair<Eigen::VectorXd, Eigen::MatrixXd> Evaluate(const Eigen::VectorXd& strain, int i) override
+    {
+        if (_prescreen and not _active[i])
+        {
+            // screened elastic IP: omega == 0, skip the strain norm. A kappa
+            // growth within this step is only picked up at the next re-screen.
+            _kappa_trial.Set(_kappa.GetScalar(i), i);
+            return {_C * strain, _C};
+        }
+
+        double kappa, dkappa, omega, domega;
+        Eigen::VectorXd deeq(strain.rows());
+
+        const double eeq = _strain_norm->EvaluateInto(strain, deeq);
         std::tie(kappa, dkappa) = EvaluateKappa(eeq, _kappa.GetScalar(i));
+        _kappa_trial.Set(kappa, i);
         std::tie(omega, domega) = _omega->Evaluate(kappa);
+        if (_prescreen)
+            _active[i] = kappa >= prescreen_margin * _omega->Kappa0();
 
         return {(1. - omega) * _C * strain, (1. - omega) * _C - _C * strain * domega * dkappa * deeq.transpose()};
     }
@@ -187,6 +289,15 @@ public:
         const double eeq = _strain_norm->Evaluate(strain).first;
         const double kappa = EvaluateKappa(eeq, _kappa.GetScalar(i)).first;
         _kappa.Set(kappa, i);
+        if (_prescreen)
+            _active[i] = std::max(eeq, kappa) >= prescreen_margin * _omega->Kappa0();
+    }
+
+    void Commit() override
+    {
+        _kappa.data.swap(_kappa_trial.data);
+        // re-screen: the next Evaluate sweep runs full again
+        _active.assign(_active.size(), true);
     }
 
     Eigen::VectorXd Kappa() const
@@ -194,12 +305,33 @@ public:
         return _kappa.data;
     }
 
+    //! @brief restores the committed history, e.g. after a gathered checkpoint
+    void SetKappa(const Eigen::VectorXd& kappa)
+    {
+        if (kappa.size() != _kappa.data.size())
+            throw std::runtime_error("The kappa size does not match the number of IPs!");
+        _kappa.data = kappa;
+    }
+
+    std::vector<std::pair<std::string, QValues*>> HistoryFields() override
+    {
+        return {{"kappa", &_kappa}};
+    }
+
 
 private:
+    //! IPs this close (relative) to `Kappa0` are kept active to not miss the
+    //! damage onset between two re-screens
+    static constexpr double prescreen_margin = 0.9;
+
     Eigen::MatrixXd _C;
     std::shared_ptr<DamageLawInterface> _omega;
     std::shared_ptr<StrainNormInterface> _strain_norm;
     QValues _kappa;
+    QValues _kappa_trial;
+    bool _prescreen = false;
+    // char, not bool: distinct elements must be writable from parallel chunks
+    std::vector<char> _active;
 };
 
 class GradientDamage : public LawInterface
@@ -211,6 +343,7 @@ public:
         , _omega(omega)
         , _strain_norm(strain_norm)
         , _kappa(1)
+        , _kappa_trial(1)
     {
     }
 
@@ -234,17 +367,141 @@ public:
     void Resize(int n) override
     {
         _kappa.Resize(n);
+        _kappa_trial.Resize(n);
+        _active.assign(n, true);
+    }
+
+    //! @brief opt-in fast path that evaluates screened elastic IPs via the
+    //! undamaged `_C` without the strain norm
+    //!
+    //! The screening on the trial kappa is exact for SIGMA and the tangents.
+    //! EEQ/DEEQ of screened IPs keep the values of their last full
+    //! evaluation; `Update`/`Commit` re-screen, so the next sweep after each
+    //! step refreshes them.
+    void SetPrescreen(bool prescreen)
+    {
+        _prescreen = prescreen;
+        _active.assign(_kappa.data.size(), true);
     }
 
     void Evaluate(const std::vector<QValues>& input, std::vector<QValues>& out, int i) override
     {
-        double kappa, dkappa, omega, domega, eeq;
-        Eigen::VectorXd deeq;
-        auto strain = input[EPS].Get(i);
+        Eigen::VectorXd deeq(_C.rows());
+        EvaluateIp(input, out, i, deeq);
+    }
+
+    void EvaluateAll(const std::vector<QValues>& input, std::vector<QValues>& out, const std::vector<int>& ips) override
+    {
+        // one workspace per call, i.e. per thread in the chunked parallel
+        // mode -- the per-IP loop itself is allocation-free
+        Eigen::VectorXd deeq(_C.rows());
+
+        if (_prescreen or not CanBatchNorm(out, ips))
+        {
+            for (int ip : ips)
+                EvaluateIp(input, out, ip, deeq);
+            return;
+        }
+
+        // batched strain norm over the whole block, then the cheap per-IP
+        // damage update -- kappa only depends on the nonlocal input E
+        const int q = _C.rows();
+        const int front = ips.front();
+        _strain_norm->EvaluateBlock(input[EPS].data.data() + q * input[EPS].Index(front),
+                                    out[EEQ].data.data() + out[EEQ].Index(front),
+                                    out[DEEQ].data.data() + q * out[DEEQ].Index(front), q,
+                                    static_cast<int>(ips.size()));
+
+        for (int ip : ips)
+        {
+            double kappa, dkappa, omega, domega;
+            auto strain = input[EPS].GetMap(ip);
+            std::tie(kappa, dkappa) = EvaluateKappa(input[E].GetScalar(ip), _kappa.GetScalar(ip));
+            _kappa_trial.Set(kappa, ip);
+            std::tie(omega, domega) = _omega->Evaluate(kappa);
+
+            out[SIGMA].Set((1. - omega) * _C * strain, ip);
+            out[DSIGMA_DE].Set(-_C * strain * domega * dkappa, ip);
+            out[DSIGMA_DEPS].Set((1. - omega) * _C, ip);
+        }
+    }
+
+    std::pair<double, double> EvaluateKappa(double eeq, double kappa) const
+    {
+        if (eeq >= kappa)
+            return {eeq, 1.};
+        else
+            return {kappa, 0};
+    }
+
+    void Update(const std::vector<QValues>& input, int i) override
+    {
+        _kappa.Set(EvaluateKappa(input[E].GetScalar(i), _kappa.GetScalar(i)).first, i);
+        // re-screen: the next Evaluate sweep refreshes EEQ/DEEQ and the flag
+        _active[i] = true;
+    }
+
+    void Commit() override
+    {
+        _kappa.data.swap(_kappa_trial.data);
+        _active.assign(_active.size(), true);
+    }
+
+    Eigen::VectorXd Kappa() const
+    {
+        return _kappa.data;
+    }
+
+    //! @brief restores the committed history, e.g. after a gathered checkpoint
+    void SetKappa(const Eigen::VectorXd& kappa)
+    {
+        if (kappa.size() != _kappa.data.size())
+            throw std::runtime_error("The kappa size does not match the number of IPs!");
+        _kappa.data = kappa;
+    }
+
+    std::vector<std::pair<std::string, QValues*>> HistoryFields() override
+    {
+        return {{"kappa", &_kappa}};
+    }
+
+
+private:
+    //! @brief the batched norm kernel needs a contiguous IP run and plain
+    //! double EEQ/DEEQ storage to write into
+    static bool CanBatchNorm(const std::vector<QValues>& out, const std::vector<int>& ips)
+    {
+        if (ips.empty())
+            return false;
+        if (out[EEQ].IsSinglePrecision() or out[DEEQ].IsSinglePrecision())
+            return false;
+        for (unsigned k = 0; k + 1 < ips.size(); ++k)
+            if (ips[k + 1] != ips[k] + 1)
+                return false;
+        return true;
+    }
+
+    void EvaluateIp(const std::vector<QValues>& input, std::vector<QValues>& out, int i, Eigen::VectorXd& deeq)
+    {
+        double kappa, dkappa, omega, domega;
+        auto strain = input[EPS].GetMap(i);
 
         std::tie(kappa, dkappa) = EvaluateKappa(input[E].GetScalar(i), _kappa.GetScalar(i));
+        _kappa_trial.Set(kappa, i);
+
+        if (_prescreen and not _active[i] and kappa <= _omega->Kappa0())
+        {
+            // guaranteed omega = domega = 0
+            out[SIGMA].Set(_C * strain, i);
+            out[DSIGMA_DE].GetMap(i).setZero();
+            out[DSIGMA_DEPS].Set(_C, i);
+            return;
+        }
+
         std::tie(omega, domega) = _omega->Evaluate(kappa);
-        std::tie(eeq, deeq) = _strain_norm->Evaluate(strain);
+        const double eeq = _strain_norm->EvaluateInto(strain, deeq);
+        if (_prescreen)
+            _active[i] = kappa >= prescreen_margin * _omega->Kappa0();
 
         out[EEQ].Set(eeq, i);
         out[SIGMA].Set((1. - omega) * _C * strain, i);
@@ -253,6 +510,219 @@ public:
         out[DSIGMA_DEPS].Set((1. - omega) * _C, i);
     }
 
+    //! IPs this close (relative) to `Kappa0` are kept active to not miss the
+    //! damage onset between two re-screens
+    static constexpr double prescreen_margin = 0.9;
+
+    Eigen::MatrixXd _C;
+    std::shared_ptr<DamageLawInterface> _omega;
+    std::shared_ptr<StrainNormInterface> _strain_norm;
+
+    // history values, trial written in Evaluate, swapped in Commit
+    QValues _kappa;
+    QValues _kappa_trial;
+    bool _prescreen = false;
+    // char, not bool: distinct elements must be writable from parallel chunks
+    std::vector<char> _active;
+};
+
+//! @brief constraint-specialized LocalDamage with all matrix products in
+//! fixed-size V<TC>/M<TC> types
+template <Constraint TC>
+class LocalDamageT : public MechanicsLaw
+{
+public:
+    static constexpr int q = Dim::Q(TC);
+
+    LocalDamageT(double E, double nu, std::shared_ptr<DamageLawInterface> omega,
+                 std::shared_ptr<StrainNormInterface> strain_norm)
+        : MechanicsLaw(TC)
+        , _C(C<TC>(E, nu))
+        , _omega(omega)
+        , _strain_norm(strain_norm)
+        , _kappa(1)
+        , _kappa_trial(1)
+    {
+    }
+
+    void Resize(int n) override
+    {
+        _kappa.Resize(n);
+        _kappa_trial.Resize(n);
+        _active.assign(n, true);
+    }
+
+    //! @brief opt-in fast path that evaluates IPs screened as elastic in the
+    //! last `Update` via the undamaged `_C` without the strain norm
+    void SetPrescreen(bool prescreen)
+    {
+        _prescreen = prescreen;
+        _active.assign(_kappa.data.size(), true);
+    }
+
+    std::pair<Eigen::VectorXd, Eigen::MatrixXd> Evaluate(const Eigen::VectorXd& strain, int i) override
+    {
+        if (_prescreen and not _active[i])
+        {
+            _kappa_trial.Set(_kappa.GetScalar(i), i);
+            return {_C * strain, _C};
+        }
+
+        double kappa, dkappa, omega, domega;
+        V<TC> deeq;
+        const V<TC> eps = strain;
+
+        const double eeq = _strain_norm->EvaluateInto(eps, deeq);
+        std::tie(kappa, dkappa) = EvaluateKappa(eeq, _kappa.GetScalar(i));
+        _kappa_trial.Set(kappa, i);
+        std::tie(omega, domega) = _omega->Evaluate(kappa);
+        if (_prescreen)
+            _active[i] = kappa >= prescreen_margin * _omega->Kappa0();
+
+        const V<TC> sigma_elastic = _C * eps;
+        const M<TC> tangent = (1. - omega) * _C - sigma_elastic * (domega * dkappa) * deeq.transpose();
+        return {(1. - omega) * sigma_elastic, tangent};
+    }
+
+    std::pair<double, double> EvaluateKappa(double eeq, double kappa) const
+    {
+        if (eeq >= kappa)
+            return {eeq, 1.};
+        else
+            return {kappa, 0};
+    }
+
+    void Update(const Eigen::VectorXd& strain, int i) override
+    {
+        const double eeq = _strain_norm->Evaluate(strain).first;
+        const double kappa = EvaluateKappa(eeq, _kappa.GetScalar(i)).first;
+        _kappa.Set(kappa, i);
+        if (_prescreen)
+            _active[i] = std::max(eeq, kappa) >= prescreen_margin * _omega->Kappa0();
+    }
+
+    void Commit() override
+    {
+        _kappa.data.swap(_kappa_trial.data);
+        // re-screen: the next Evaluate sweep runs full again
+        _active.assign(_active.size(), true);
+    }
+
+    Eigen::VectorXd Kappa() const
+    {
+        return _kappa.data;
+    }
+
+    //! @brief restores the committed history, e.g. after a gathered checkpoint
+    void SetKappa(const Eigen::VectorXd& kappa)
+    {
+        if (kappa.size() != _kappa.data.size())
+            throw std::runtime_error("The kappa size does not match the number of IPs!");
+        _kappa.data = kappa;
+    }
+
+    std::vector<std::pair<std::string, QValues*>> HistoryFields() override
+    {
+        return {{"kappa", &_kappa}};
+    }
+
+private:
+    static constexpr double prescreen_margin = 0.9;
+
+    const M<TC> _C;
+    std::shared_ptr<DamageLawInterface> _omega;
+    std::shared_ptr<StrainNormInterface> _strain_norm;
+    QValues _kappa;
+    QValues _kappa_trial;
+    bool _prescreen = false;
+    std::vector<char> _active;
+};
+
+//! @brief constraint-specialized GradientDamage reading and writing the
+//! QValues storage through fixed-size maps
+template <Constraint TC>
+class GradientDamageT : public LawInterface
+{
+public:
+    static constexpr int q = Dim::Q(TC);
+
+    GradientDamageT(double E, double nu, std::shared_ptr<DamageLawInterface> omega,
+                    std::shared_ptr<StrainNormInterface> strain_norm)
+        : _C(C<TC>(E, nu))
+        , _omega(omega)
+        , _strain_norm(strain_norm)
+        , _kappa(1)
+        , _kappa_trial(1)
+    {
+    }
+
+    void DefineOutputs(std::vector<QValues>& out) const override
+    {
+        out[EEQ] = QValues(1);
+        out[DEEQ] = QValues(q);
+        out[SIGMA] = QValues(q);
+        out[DSIGMA_DE] = QValues(q);
+        out[DSIGMA_DEPS] = QValues(q, q);
+    }
+
+    void DefineInputs(std::vector<QValues>& input) const override
+    {
+        input[E] = QValues(1);
+        input[EPS] = QValues(q);
+    }
+
+    void Resize(int n) override
+    {
+        _kappa.Resize(n);
+        _kappa_trial.Resize(n);
+        _active.assign(n, true);
+    }
+
+    //! @brief opt-in fast path that evaluates screened elastic IPs via the
+    //! undamaged `_C` without the strain norm, see `GradientDamage`
+    void SetPrescreen(bool prescreen)
+    {
+        _prescreen = prescreen;
+        _active.assign(_kappa.data.size(), true);
+    }
+
+    void Evaluate(const std::vector<QValues>& input, std::vector<QValues>& out, int i) override
+    {
+        double kappa, dkappa, omega, domega;
+        V<TC> deeq;
+        const V<TC> strain = input[EPS].GetMap<q, 1>(i);
+
+        std::tie(kappa, dkappa) = EvaluateKappa(input[E].GetScalar(i), _kappa.GetScalar(i));
+        _kappa_trial.Set(kappa, i);
+
+        if (_prescreen and not _active[i] and kappa <= _omega->Kappa0())
+        {
+            // guaranteed omega = domega = 0, EEQ/DEEQ keep their last
+            // fully evaluated values
+            out[SIGMA].GetMap<q, 1>(i) = _C * strain;
+            out[DSIGMA_DE].GetMap<q, 1>(i).setZero();
+            out[DSIGMA_DEPS].GetMap<q, q>(i) = _C;
+            return;
+        }
+
+        std::tie(omega, domega) = _omega->Evaluate(kappa);
+        const double eeq = _strain_norm->EvaluateInto(strain, deeq);
+        if (_prescreen)
+            _active[i] = kappa >= prescreen_margin * _omega->Kappa0();
+
+        out[EEQ].Set(eeq, i);
+        out[SIGMA].GetMap<q, 1>(i) = (1. - omega) * _C * strain;
+        out[DEEQ].GetMap<q, 1>(i) = deeq;
+        out[DSIGMA_DE].GetMap<q, 1>(i) = -_C * strain * domega * dkappa;
+        out[DSIGMA_DEPS].GetMap<q, q>(i) = (1. - omega) * _C;
+    }
+
+    void EvaluateAll(const std::vector<QValues>& input, std::vector<QValues>& out, const std::vector<int>& ips) override
+    {
+        for (int ip : ips)
+            GradientDamageT::Evaluate(input, out, ip);
+    }
+
     std::pair<double, double> EvaluateKappa(double eeq, double kappa) const
     {
         if (eeq >= kappa)
@@ -264,6 +734,14 @@ public:
     void Update(const std::vector<QValues>& input, int i) override
     {
         _kappa.Set(EvaluateKappa(input[E].GetScalar(i), _kappa.GetScalar(i)).first, i);
+        // re-screen: the next Evaluate sweep refreshes EEQ/DEEQ and the flag
+        _active[i] = true;
+    }
+
+    void Commit() override
+    {
+        _kappa.data.swap(_kappa_trial.data);
+        _active.assign(_active.size(), true);
     }
 
     Eigen::VectorXd Kappa() const
@@ -271,13 +749,171 @@ public:
         return _kappa.data;
     }
 
+    //! @brief restores the committed history, e.g. after a gathered checkpoint
+    void SetKappa(const Eigen::VectorXd& kappa)
+    {
+        if (kappa.size() != _kappa.data.size())
+            throw std::runtime_error("The kappa size does not match the number of IPs!");
+        _kappa.data = kappa;
+    }
+
+    std::vector<std::pair<std::string, QValues*>> HistoryFields() override
+    {
+        return {{"kappa", &_kappa}};
+    }
 
 private:
-    Eigen::MatrixXd _C;
+    static constexpr double prescreen_margin = 0.9;
+
+    const M<TC> _C;
     std::shared_ptr<DamageLawInterface> _omega;
     std::shared_ptr<StrainNormInterface> _strain_norm;
 
-    // history values
+    // history values, trial written in Evaluate, swapped in Commit
     QValues _kappa;
+    QValues _kappa_trial;
+    bool _prescreen = false;
+    std::vector<char> _active;
 };
 
+//! @brief statically composed GradientDamage: damage law and strain norm are
+//! template policies held by value, so their Evaluate calls -- the two
+//! hottest inner functions of every damage run -- compile to direct,
+//! inlinable calls instead of virtual dispatch returning heap pairs
+//!
+//! `DamageLawExponential` and `ModMisesEeq` are the first concrete policies;
+//! the common combinations are explicitly bound in constitutive.cpp.
+template <typename TOmega, typename TNorm, Constraint TC>
+class GradientDamageStatic : public LawInterface
+{
+public:
+    static constexpr int q = Dim::Q(TC);
+
+    GradientDamageStatic(double E, double nu, TOmega omega, TNorm strain_norm)
+        : _C(C<TC>(E, nu))
+        , _omega(std::move(omega))
+        , _strain_norm(std::move(strain_norm))
+        , _kappa(1)
+        , _kappa_trial(1)
+    {
+    }
+
+    void DefineOutputs(std::vector<QValues>& out) const override
+    {
+        out[EEQ] = QValues(1);
+        out[DEEQ] = QValues(q);
+        out[SIGMA] = QValues(q);
+        out[DSIGMA_DE] = QValues(q);
+        out[DSIGMA_DEPS] = QValues(q, q);
+    }
+
+    void DefineInputs(std::vector<QValues>& input) const override
+    {
+        input[E] = QValues(1);
+        input[EPS] = QValues(q);
+    }
+
+    void Resize(int n) override
+    {
+        _kappa.Resize(n);
+        _kappa_trial.Resize(n);
+        _active.assign(n, true);
+    }
+
+    //! @brief opt-in fast path that evaluates screened elastic IPs via the
+    //! undamaged `_C` without the strain norm, see `GradientDamage`
+    void SetPrescreen(bool prescreen)
+    {
+        _prescreen = prescreen;
+        _active.assign(_kappa.data.size(), true);
+    }
+
+    void Evaluate(const std::vector<QValues>& input, std::vector<QValues>& out, int i) override
+    {
+        double kappa, dkappa, omega, domega;
+        V<TC> deeq;
+        const V<TC> strain = input[EPS].GetMap<q, 1>(i);
+
+        std::tie(kappa, dkappa) = EvaluateKappa(input[E].GetScalar(i), _kappa.GetScalar(i));
+        _kappa_trial.Set(kappa, i);
+
+        if (_prescreen and not _active[i] and kappa <= _omega.Kappa0())
+        {
+            // guaranteed omega = domega = 0, EEQ/DEEQ keep their last
+            // fully evaluated values
+            out[SIGMA].GetMap<q, 1>(i) = _C * strain;
+            out[DSIGMA_DE].GetMap<q, 1>(i).setZero();
+            out[DSIGMA_DEPS].GetMap<q, q>(i) = _C;
+            return;
+        }
+
+        std::tie(omega, domega) = _omega.Evaluate(kappa);
+        const double eeq = _strain_norm.EvaluateInto(strain, deeq);
+        if (_prescreen)
+            _active[i] = kappa >= prescreen_margin * _omega.Kappa0();
+
+        out[EEQ].Set(eeq, i);
+        out[SIGMA].GetMap<q, 1>(i) = (1. - omega) * _C * strain;
+        out[DEEQ].GetMap<q, 1>(i) = deeq;
+        out[DSIGMA_DE].GetMap<q, 1>(i) = -_C * strain * domega * dkappa;
+        out[DSIGMA_DEPS].GetMap<q, q>(i) = (1. - omega) * _C;
+    }
+
+    void EvaluateAll(const std::vector<QValues>& input, std::vector<QValues>& out, const std::vector<int>& ips) override
+    {
+        for (int ip : ips)
+            GradientDamageStatic::Evaluate(input, out, ip);
+    }
+
+    std::pair<double, double> EvaluateKappa(double eeq, double kappa) const
+    {
+        if (eeq >= kappa)
+            return {eeq, 1.};
+        else
+            return {kappa, 0};
+    }
+
+    void Update(const std::vector<QValues>& input, int i) override
+    {
+        _kappa.Set(EvaluateKappa(input[E].GetScalar(i), _kappa.GetScalar(i)).first, i);
+        // re-screen: the next Evaluate sweep refreshes EEQ/DEEQ and the flag
+        _active[i] = true;
+    }
+
+    void Commit() override
+    {
+        _kappa.data.swap(_kappa_trial.data);
+        _active.assign(_active.size(), true);
+    }
+
+    Eigen::VectorXd Kappa() const
+    {
+        return _kappa.data;
+    }
+
+    //! @brief restores the committed history, e.g. after a gathered checkpoint
+    void SetKappa(const Eigen::VectorXd& kappa)
+    {
+        if (kappa.size() != _kappa.data.size())
+            throw std::runtime_error("The kappa size does not match the number of IPs!");
+        _kappa.data = kappa;
+    }
+
+    std::vector<std::pair<std::string, QValues*>> HistoryFields() override
+    {
+        return {{"kappa", &_kappa}};
+    }
+
+private:
+    static constexpr double prescreen_margin = 0.9;
+
+    const M<TC> _C;
+    const TOmega _omega;
+    const TNorm _strain_norm;
+
+    // history values, trial written in Evaluate, swapped in Commit
+    QValues _kappa;
+    QValues _kappa_trial;
+    bool _prescreen = false;
+    std::vector<char> _active;
+};
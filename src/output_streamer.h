@@ -0,0 +1,247 @@
+#pragma once
+#include "interfaces.h"
+
+//! @brief streaming time-series output of per-IP fields with online
+//! compression
+//!
+//! Registered Q slots and history fields are snapshotted in `WriteFrame`
+//! and appended to one binary file on a background thread, double-buffered
+//! against the solver, so output I/O overlaps computation. Frames are
+//! delta-encoded against the previous frame with run-length coding of the
+//! unchanged values -- for slowly-evolving damage fields, where most IPs do
+//! not move between outputs, this shrinks the on-disk size by an order of
+//! magnitude without any external compression dependency.
+//!
+//! `ReadFrames` is the matching decoder for post-processing.
+class OutputStreamer
+{
+public:
+    OutputStreamer(IpLoop& loop, const std::string& path)
+        : _loop(loop)
+        , _file(path, std::ios::binary | std::ios::trunc)
+    {
+        if (not _file)
+            throw std::runtime_error("Cannot open '" + path + "' for writing!");
+    }
+
+    ~OutputStreamer()
+    {
+        Flush();
+    }
+
+    //! @brief registers the output slot `what`, e.g. SIGMA
+    void Register(Q what)
+    {
+        RequireNoFrame();
+        _slots.push_back(what);
+        _names.push_back("q" + std::to_string(what));
+    }
+
+    //! @brief registers a history field by its prefixed name, e.g.
+    //! "law0/kappa", see IpLoop::HistoryFields
+    void RegisterHistory(const std::string& name)
+    {
+        RequireNoFrame();
+        for (const auto& field : _loop.HistoryFields())
+            if (field.first == name)
+            {
+                _history.push_back(field.second);
+                _names.push_back(name);
+                return;
+            }
+        throw std::runtime_error("No history field '" + name + "' in this loop!");
+    }
+
+    //! @brief snapshots the registered fields and appends them as one frame
+    //! on the background thread; blocks only if the previous frame is still
+    //! being written
+    void WriteFrame(double time = 0.)
+    {
+        Flush();
+        if (_frames == 0)
+            WriteHeader();
+
+        // double buffer: the snapshot is cheap, encoding and I/O are not
+        _staging.clear();
+        for (Q what : _slots)
+            _staging.push_back(_loop.Get(what));
+        for (QValues* history : _history)
+            _staging.push_back(history->IsSinglePrecision() ? history->data_f.cast<double>() : history->data);
+
+        _writer = std::async(std::launch::async, [this, time]() {
+            _file.write(reinterpret_cast<const char*>(&time), sizeof(time));
+            for (unsigned iField = 0; iField < _staging.size(); ++iField)
+            {
+                WriteDelta(_staging[iField], iField < _previous.size() ? &_previous[iField] : nullptr);
+            }
+            _previous = _staging;
+        });
+        ++_frames;
+    }
+
+    //! @brief blocks until the pending frame (if any) is on disk
+    void Flush()
+    {
+        if (_writer.valid())
+            _writer.get();
+        _file.flush();
+    }
+
+    //! @brief decodes a streamed file into (time, field values) frames, the
+    //! fields ordered as registered; `names` receives the field names
+    static std::vector<std::pair<double, std::vector<Eigen::VectorXd>>> ReadFrames(const std::string& path,
+                                                                                  std::vector<std::string>* names = nullptr)
+    {
+        std::ifstream file(path, std::ios::binary);
+        if (not file)
+            throw std::runtime_error("Cannot open '" + path + "'!");
+
+        char magic[9] = {};
+        file.read(magic, 8);
+        if (std::string(magic) != "CONSTSTR")
+            throw std::runtime_error("'" + path + "' is no constitutive output stream!");
+        const std::uint64_t version = ReadU64(file);
+        if (version != 1)
+            throw std::runtime_error("Unsupported stream format version!");
+        const std::uint64_t n_fields = ReadU64(file);
+
+        std::vector<std::uint64_t> sizes(n_fields);
+        for (std::uint64_t iField = 0; iField < n_fields; ++iField)
+        {
+            const std::uint64_t name_size = ReadU64(file);
+            std::string name(name_size, '\0');
+            file.read(&name[0], name_size);
+            if (names)
+                names->push_back(name);
+            sizes[iField] = ReadU64(file);
+        }
+
+        std::vector<std::pair<double, std::vector<Eigen::VectorXd>>> frames;
+        std::vector<Eigen::VectorXd> previous(n_fields);
+        for (std::uint64_t iField = 0; iField < n_fields; ++iField)
+            previous[iField] = Eigen::VectorXd::Zero(sizes[iField]);
+
+        while (true)
+        {
+            double time;
+            file.read(reinterpret_cast<char*>(&time), sizeof(time));
+            if (not file)
+            {
+                // clean end only at a frame boundary
+                if (file.gcount() != 0)
+                    throw std::runtime_error("Corrupt output stream!");
+                break;
+            }
+            for (std::uint64_t iField = 0; iField < n_fields; ++iField)
+                ReadDelta(file, previous[iField]);
+            frames.emplace_back(time, previous);
+        }
+        return frames;
+    }
+
+private:
+    void RequireNoFrame() const
+    {
+        if (_frames != 0)
+            throw std::runtime_error("Register all fields before the first frame!");
+    }
+
+    void WriteHeader()
+    {
+        _file.write("CONSTSTR", 8);
+        WriteU64(1); // format version
+        WriteU64(_names.size());
+
+        unsigned iField = 0;
+        for (Q what : _slots)
+        {
+            WriteU64(_names[iField].size());
+            _file.write(_names[iField].data(), _names[iField].size());
+            WriteU64(_loop.Get(what).size());
+            ++iField;
+        }
+        for (QValues* history : _history)
+        {
+            WriteU64(_names[iField].size());
+            _file.write(_names[iField].data(), _names[iField].size());
+            WriteU64(history->IsSinglePrecision() ? history->data_f.size() : history->data.size());
+            ++iField;
+        }
+    }
+
+    //! @brief one field of one frame: alternating (unchanged run, literal
+    //! run) token pairs relative to the previous frame; an unchanged run
+    //! costs 16 bytes regardless of its length, changed values are stored
+    //! raw, so the round trip is bit-exact
+    void WriteDelta(const Eigen::VectorXd& values, const Eigen::VectorXd* previous)
+    {
+        const long n = values.size();
+        long i = 0;
+        while (i < n)
+        {
+            long unchanged = 0;
+            while (i + unchanged < n and not Changed(values, previous, i + unchanged))
+                ++unchanged;
+            long literals = 0;
+            while (i + unchanged + literals < n and Changed(values, previous, i + unchanged + literals))
+                ++literals;
+
+            WriteU64(unchanged);
+            WriteU64(literals);
+            for (long k = i + unchanged; k < i + unchanged + literals; ++k)
+                _file.write(reinterpret_cast<const char*>(&values[k]), sizeof(double));
+            i += unchanged + literals;
+        }
+    }
+
+    static bool Changed(const Eigen::VectorXd& values, const Eigen::VectorXd* previous, long k)
+    {
+        return previous ? values[k] != (*previous)[k] : values[k] != 0.;
+    }
+
+    static void ReadDelta(std::ifstream& file, Eigen::VectorXd& field)
+    {
+        long i = 0;
+        while (i < field.size())
+        {
+            const long unchanged = ReadU64(file);
+            const long literals = ReadU64(file);
+            if (i + unchanged + literals > field.size())
+                throw std::runtime_error("Corrupt output stream!");
+            for (long k = i + unchanged; k < i + unchanged + literals; ++k)
+            {
+                file.read(reinterpret_cast<char*>(&field[k]), sizeof(double));
+                if (not file)
+                    throw std::runtime_error("Corrupt output stream!");
+            }
+            i += unchanged + literals;
+        }
+    }
+
+    void WriteU64(std::uint64_t value)
+    {
+        _file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+
+    //! @brief a failed read means the file was cut inside a frame, e.g. by a
+    //! dying job -- throwing here (instead of returning 0) keeps the decoder
+    //! from looping forever on zero-length token pairs
+    static std::uint64_t ReadU64(std::ifstream& file)
+    {
+        std::uint64_t value = 0;
+        file.read(reinterpret_cast<char*>(&value), sizeof(value));
+        if (not file)
+            throw std::runtime_error("Corrupt output stream!");
+        return value;
+    }
+
+    IpLoop& _loop;
+    std::ofstream _file;
+    std::vector<Q> _slots;
+    std::vector<QValues*> _history;
+    std::vector<std::string> _names;
+    std::vector<Eigen::VectorXd> _staging;
+    std::vector<Eigen::VectorXd> _previous;
+    std::future<void> _writer;
+    long _frames = 0;
+};
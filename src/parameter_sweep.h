@@ -0,0 +1,176 @@
+#pragma once
+#include "local_damage.h"
+
+//! @brief one (E, nu) sample of `LinearElastic`
+struct LinearElasticParameters
+{
+    double E;
+    double nu;
+};
+
+//! @brief one sample of `LocalDamage` with `DamageLawExponential`
+struct LocalDamageParameters
+{
+    double E;
+    double nu;
+    double k0;
+    double alpha;
+    double beta;
+};
+
+//! @brief batch evaluation of one strain state under many parameter samples
+//!
+//! Stochastic calibration evaluates the same strain history under hundreds
+//! of parameter sets; run as separate `IpLoop`s, every sample re-streams all
+//! strains through memory. The sweep inverts the loop order: for each IP,
+//! all samples are evaluated while its strain is hot in cache
+//! (sample-inner loop), IPs distributed over the threads.
+//!
+//! Results and history use the n_ips x n_samples layout: the values of
+//! sample `s` at IP `i` start at `(i * NumSamples() + s) * q`.
+class ParameterSweep
+{
+public:
+    ParameterSweep(int q, int n_samples)
+        : _q(q)
+        , _n_samples(n_samples)
+    {
+        if (_n_samples == 0)
+            throw std::runtime_error("The parameter sweep needs at least one sample!");
+    }
+
+    virtual ~ParameterSweep() = default;
+
+    virtual void Resize(int n)
+    {
+        _n = n;
+        _sigma.setZero(static_cast<long>(n) * _n_samples * _q);
+    }
+
+    int NumSamples() const
+    {
+        return _n_samples;
+    }
+
+    //! @brief evaluates all samples at all IPs of `all_strains`
+    void Evaluate(const Eigen::VectorXd& all_strains, int threads = 1)
+    {
+        if (all_strains.size() != static_cast<long>(_n) * _q)
+            throw std::runtime_error("The strain size does not match the number of IPs!");
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(threads) schedule(static) if (threads > 1)
+#endif
+        for (int ip = 0; ip < _n; ++ip)
+            EvaluateIp(all_strains.segment(static_cast<long>(_q) * ip, _q), ip);
+    }
+
+    //! @brief the stresses of the last `Evaluate` in n_ips x n_samples layout
+    const Eigen::VectorXd& Sigma() const
+    {
+        return _sigma;
+    }
+
+    //! @brief commits the trial history of the last `Evaluate` for all samples
+    virtual void Commit()
+    {
+    }
+
+protected:
+    //! @brief evaluates all samples of IP `ip`, the sample-inner loop
+    virtual void EvaluateIp(Eigen::Ref<const Eigen::VectorXd> strain, int ip) = 0;
+
+    const int _q;
+    const int _n_samples;
+    int _n = 0;
+    Eigen::VectorXd _sigma;
+};
+
+class LinearElasticSweep : public ParameterSweep
+{
+public:
+    LinearElasticSweep(const std::vector<LinearElasticParameters>& samples, Constraint c)
+        : ParameterSweep(Dim::Q(c), samples.size())
+    {
+        _C.reserve(samples.size());
+        for (const auto& sample : samples)
+            _C.push_back(C(sample.E, sample.nu, c));
+    }
+
+protected:
+    void EvaluateIp(Eigen::Ref<const Eigen::VectorXd> strain, int ip) override
+    {
+        for (int s = 0; s < _n_samples; ++s)
+            _sigma.segment((static_cast<long>(ip) * _n_samples + s) * _q, _q).noalias() = _C[s] * strain;
+    }
+
+private:
+    std::vector<Eigen::MatrixXd> _C;
+};
+
+class LocalDamageSweep : public ParameterSweep
+{
+public:
+    //! @brief `k` is the compressive/tensile strength ratio of the shared
+    //! modified Mises strain norm, see `ModMisesEeq`
+    LocalDamageSweep(const std::vector<LocalDamageParameters>& samples, double k, Constraint c)
+        : ParameterSweep(Dim::Q(c), samples.size())
+    {
+        _C.reserve(samples.size());
+        _omega.reserve(samples.size());
+        _norm.reserve(samples.size());
+        for (const auto& sample : samples)
+        {
+            _C.push_back(C(sample.E, sample.nu, c));
+            _omega.emplace_back(sample.k0, sample.alpha, sample.beta);
+            _norm.emplace_back(k, sample.nu, c);
+        }
+    }
+
+    void Resize(int n) override
+    {
+        ParameterSweep::Resize(n);
+        _kappa.setZero(static_cast<long>(n) * _n_samples);
+        _kappa_trial.setZero(static_cast<long>(n) * _n_samples);
+    }
+
+    void Commit() override
+    {
+        _kappa.swap(_kappa_trial);
+    }
+
+    //! @brief the committed history in n_ips x n_samples layout
+    const Eigen::VectorXd& Kappa() const
+    {
+        return _kappa;
+    }
+
+    void SetKappa(const Eigen::VectorXd& kappa)
+    {
+        if (kappa.size() != _kappa.size())
+            throw std::runtime_error("The kappa size does not match the number of IPs times samples!");
+        _kappa = kappa;
+    }
+
+protected:
+    void EvaluateIp(Eigen::Ref<const Eigen::VectorXd> strain, int ip) override
+    {
+        // stack-allocated up to the FULL constraint
+        Eigen::Matrix<double, Eigen::Dynamic, 1, 0, 6, 1> deeq(_q);
+        for (int s = 0; s < _n_samples; ++s)
+        {
+            const double eeq = _norm[s].EvaluateInto(strain, deeq);
+            const double kappa = std::max(eeq, _kappa[static_cast<long>(ip) * _n_samples + s]);
+            _kappa_trial[static_cast<long>(ip) * _n_samples + s] = kappa;
+            const double omega = _omega[s].Evaluate(kappa).first;
+            _sigma.segment((static_cast<long>(ip) * _n_samples + s) * _q, _q).noalias() =
+                    (1. - omega) * (_C[s] * strain);
+        }
+    }
+
+private:
+    std::vector<Eigen::MatrixXd> _C;
+    std::vector<DamageLawExponential> _omega;
+    std::vector<ModMisesEeq> _norm;
+    Eigen::VectorXd _kappa;
+    Eigen::VectorXd _kappa_trial;
+};
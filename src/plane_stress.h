@@ -0,0 +1,177 @@
+#pragma once
+#include "interfaces.h"
+#include <eigen3/Eigen/Dense>
+
+//! @brief plane-stress condensation wrapper making any FULL-constraint law
+//! usable in 2D plane-stress runs
+//!
+//! The out-of-plane strains (zz and the two transverse shears) are
+//! condensed per IP by a Newton iteration on the constraint sigma_oop = 0,
+//! using the out-of-plane block of the wrapped law's 6x6 tangent -- all in
+//! fixed-size 6x6/3x3 Eigen math. The exposed 3x3 tangent is the static
+//! condensation C_pp - C_po C_oo^-1 C_op of the converged 6x6 tangent. The
+//! converged out-of-plane strains are kept per IP as the warm start of the
+//! next iteration.
+//!
+//! Supported wrapped laws read EPS (plus optionally DEL_T) and write SIGMA /
+//! DSIGMA_DEPS -- the elastic/plastic/viscoplastic family. Nonlocal laws
+//! with the E input are not condensable this way.
+class PlaneStressAdapter : public LawInterface
+{
+public:
+    PlaneStressAdapter(std::shared_ptr<LawInterface> law, double tol = 1.e-10, int max_iter = 20)
+        : _law(law)
+        , _tol(tol)
+        , _max_iter(max_iter)
+        , _in3d(Q::LAST)
+        , _out3d(Q::LAST)
+        , _eps_oop(3)
+    {
+        _law->DefineInputs(_in3d);
+        _law->DefineOutputs(_out3d);
+        if (_in3d[EPS]._rows != 6)
+            throw std::runtime_error("PlaneStressAdapter wraps FULL-constraint laws only!");
+        if (_in3d[E].IsUsed() or _out3d[DSIGMA_DE].IsUsed())
+            throw std::runtime_error("Nonlocal laws cannot be condensed to plane stress!");
+    }
+
+    void DefineOutputs(std::vector<QValues>& out) const override
+    {
+        out[SIGMA] = QValues(3);
+        out[DSIGMA_DEPS] = QValues(3, 3);
+    }
+
+    void DefineInputs(std::vector<QValues>& input) const override
+    {
+        input[EPS] = QValues(3);
+        if (_in3d[DEL_T].IsUsed())
+            input[DEL_T] = QValues(1);
+    }
+
+    void Resize(int n) override
+    {
+        _law->Resize(n);
+        for (auto& qvalues : _in3d)
+            if (qvalues.IsUsed())
+                qvalues.Resize(n);
+        for (auto& qvalues : _out3d)
+            if (qvalues.IsUsed())
+                qvalues.Resize(n);
+        _eps_oop.Resize(n);
+    }
+
+    void Evaluate(const std::vector<QValues>& input, std::vector<QValues>& out, int i) override
+    {
+        const Eigen::Matrix<double, 6, 6> C66 = Condense(input, i);
+        const Eigen::Matrix<double, 6, 1> sig6 = _out3d[SIGMA].GetMap<6, 1>(i);
+
+        out[SIGMA].Set(InPlane(sig6), i);
+        out[DSIGMA_DEPS].Set(CondensedTangent(C66), i);
+    }
+
+    void EvaluateAll(const std::vector<QValues>& input, std::vector<QValues>& out, const std::vector<int>& ips) override
+    {
+        for (int ip : ips)
+            PlaneStressAdapter::Evaluate(input, out, ip);
+    }
+
+    void Update(const std::vector<QValues>& input, int i) override
+    {
+        Condense(input, i);
+        _law->Update(_in3d, i);
+    }
+
+    void Commit() override
+    {
+        _law->Commit();
+    }
+
+    std::vector<std::pair<std::string, QValues*>> HistoryFields() override
+    {
+        auto fields = _law->HistoryFields();
+        fields.emplace_back("eps_oop", &_eps_oop);
+        return fields;
+    }
+
+    std::map<std::string, Eigen::VectorXd> Stats() const override
+    {
+        return _law->Stats();
+    }
+
+private:
+    // in-plane (xx, yy, xy) and out-of-plane (zz, yz, xz) Voigt indices
+    static constexpr int p0 = 0, p1 = 1, p2 = 5;
+    static constexpr int o0 = 2, o1 = 3, o2 = 4;
+
+    //! @brief iterates the wrapped law at IP `i` until sigma_oop = 0; leaves
+    //! the converged state in _in3d/_out3d and the warm start in _eps_oop
+    Eigen::Matrix<double, 6, 6> Condense(const std::vector<QValues>& input, int i)
+    {
+        if (_in3d[DEL_T].IsUsed())
+            _in3d[DEL_T].Set(input[DEL_T].GetScalar(i), i);
+
+        const Eigen::Matrix<double, 3, 1> eps_p = input[EPS].GetMap<3, 1>(i);
+        Eigen::Matrix<double, 3, 1> eps_o = _eps_oop.GetMap<3, 1>(i);
+
+        Eigen::Matrix<double, 6, 6> C66;
+        for (int iteration = 0;; ++iteration)
+        {
+            Eigen::Matrix<double, 6, 1> eps6;
+            eps6[p0] = eps_p[0];
+            eps6[p1] = eps_p[1];
+            eps6[p2] = eps_p[2];
+            eps6[o0] = eps_o[0];
+            eps6[o1] = eps_o[1];
+            eps6[o2] = eps_o[2];
+            _in3d[EPS].Set(eps6, i);
+            _law->Evaluate(_in3d, _out3d, i);
+
+            const Eigen::Matrix<double, 6, 1> sig6 = _out3d[SIGMA].GetMap<6, 1>(i);
+            C66 = _out3d[DSIGMA_DEPS].GetMap<6, 6>(i);
+
+            const Eigen::Matrix<double, 3, 1> r(sig6[o0], sig6[o1], sig6[o2]);
+            if (r.norm() < _tol * (1. + sig6.norm()))
+                break;
+            if (iteration >= _max_iter)
+                throw std::runtime_error("The plane-stress condensation did not converge!");
+
+            Eigen::Matrix<double, 3, 3> Coo;
+            Coo << C66(o0, o0), C66(o0, o1), C66(o0, o2), C66(o1, o0), C66(o1, o1), C66(o1, o2), C66(o2, o0),
+                    C66(o2, o1), C66(o2, o2);
+            eps_o -= Coo.lu().solve(r);
+        }
+
+        _eps_oop.Set(eps_o, i);
+        return C66;
+    }
+
+    static Eigen::Matrix<double, 3, 1> InPlane(const Eigen::Matrix<double, 6, 1>& v)
+    {
+        return Eigen::Matrix<double, 3, 1>(v[p0], v[p1], v[p2]);
+    }
+
+    static Eigen::Matrix<double, 3, 3> CondensedTangent(const Eigen::Matrix<double, 6, 6>& C66)
+    {
+        Eigen::Matrix<double, 3, 3> Cpp, Coo, Cpo, Cop;
+        const int p[3] = {p0, p1, p2};
+        const int o[3] = {o0, o1, o2};
+        for (int r = 0; r < 3; ++r)
+            for (int col = 0; col < 3; ++col)
+            {
+                Cpp(r, col) = C66(p[r], p[col]);
+                Coo(r, col) = C66(o[r], o[col]);
+                Cpo(r, col) = C66(p[r], o[col]);
+                Cop(r, col) = C66(o[r], p[col]);
+            }
+        return Cpp - Cpo * Coo.lu().solve(Cop);
+    }
+
+    std::shared_ptr<LawInterface> _law;
+    const double _tol;
+    const int _max_iter;
+    std::vector<QValues> _in3d;
+    std::vector<QValues> _out3d;
+
+    // converged out-of-plane strains, the warm start of the next iteration
+    QValues _eps_oop;
+};
@@ -1,5 +1,7 @@
 #pragma once
-#include "interfaces.h"
+#include "linear_elastic.h"
+#include <eigen3/Eigen/Dense>
+#include <map>
 #include <tuple>
 
 class NormVM
@@ -28,7 +30,9 @@ public:
         }
         else if (_q == 6)
         {
-            // kein bock.
+            _P << 2, -1, -1, 0, 0, 0, -1, 2, -1, 0, 0, 0, -1, -1, 2, 0, 0, 0, 0, 0, 0, f, 0, 0, 0, 0, 0, 0, f, 0, 0,
+                    0, 0, 0, 0, f;
+            _P *= 1. / 3.;
         }
     }
 
@@ -83,4 +87,452 @@ public:
     {
     return {_p, _dp_dsig, _dp_dk};
     }
-};
\ No newline at end of file
+};
+
+//! @brief von Mises yield function f = se - (y0 + H kappa) with associated
+//! flow vector m = df/dsigma and its stress derivative dm
+class YieldVM
+{
+public:
+    YieldVM(double y0, Constraint c, double H = 0.)
+        : _y0(y0)
+        , _H(H)
+        , _norm(c)
+    {
+    }
+
+    void Evaluate(const Eigen::VectorXd& stress, double kappa, double& f, Eigen::VectorXd& m, Eigen::MatrixXd& dm,
+                  double& fk) const
+    {
+        double se;
+        std::tie(se, m) = _norm.Call(stress);
+        f = se - (_y0 + _H * kappa);
+        fk = -_H;
+
+        const int q = _norm._q;
+        if (q == 1 or se == 0.)
+            dm = Eigen::MatrixXd::Zero(q, q);
+        else
+            dm = (1.5 * _norm._P - m * m.transpose()) / se;
+    }
+
+private:
+    const double _y0;
+    const double _H;
+    NormVM _norm;
+};
+
+//! @brief von Mises plasticity with isotropic hardening
+//!
+//! The return mapping solves the coupled residuals (stress, history, yield
+//! function) with a full Newton iteration per IP -- the C++ counterpart of
+//! PlasticConsitutiveRateIndependentHistory in test/test_plasticity.py.
+//! Plastic strains and kappa live in QValues history with a trial buffer,
+//! so Commit() is an O(1) swap.
+class MisesPlasticity : public LawInterface
+{
+public:
+    MisesPlasticity(double E, double nu, Constraint c, double sigma_y, double H = 0., double tol = 1.e-9,
+                    int max_iter = 20)
+        : _q(Dim::Q(c))
+        , _C(C(E, nu, c))
+        , _yf(sigma_y, c, H)
+        , _tol(tol)
+        , _max_iter(max_iter)
+        , _eps_p(_q)
+        , _eps_p_trial(_q)
+        , _kappa(1)
+        , _kappa_trial(1)
+        , _newton_iterations(1)
+    {
+    }
+
+    void DefineOutputs(std::vector<QValues>& out) const override
+    {
+        out[SIGMA] = QValues(_q);
+        out[DSIGMA_DEPS] = QValues(_q, _q);
+    }
+
+    void DefineInputs(std::vector<QValues>& input) const override
+    {
+        input[EPS] = QValues(_q);
+    }
+
+    void Resize(int n) override
+    {
+        _eps_p.Resize(n);
+        _eps_p_trial.Resize(n);
+        _kappa.Resize(n);
+        _kappa_trial.Resize(n);
+        _newton_iterations.Resize(n);
+    }
+
+    void Evaluate(const std::vector<QValues>& input, std::vector<QValues>& out, int i) override
+    {
+        Eigen::VectorXd sigma, eps_p;
+        Eigen::MatrixXd Ct;
+        double kappa;
+        const int iterations = ReturnMapping(input[EPS].GetMap(i), _eps_p.Get(i), _kappa.GetScalar(i), sigma, Ct,
+                                             eps_p, kappa);
+
+        out[SIGMA].Set(sigma, i);
+        out[DSIGMA_DEPS].Set(Ct, i);
+        _eps_p_trial.Set(eps_p, i);
+        _kappa_trial.Set(kappa, i);
+        _newton_iterations.Set(static_cast<double>(iterations), i);
+    }
+
+    void EvaluateAll(const std::vector<QValues>& input, std::vector<QValues>& out, const std::vector<int>& ips) override
+    {
+        for (int ip : ips)
+            MisesPlasticity::Evaluate(input, out, ip);
+    }
+
+    void Update(const std::vector<QValues>& input, int i) override
+    {
+        Eigen::VectorXd sigma, eps_p;
+        Eigen::MatrixXd Ct;
+        double kappa;
+        ReturnMapping(input[EPS].GetMap(i), _eps_p.Get(i), _kappa.GetScalar(i), sigma, Ct, eps_p, kappa);
+        _eps_p.Set(eps_p, i);
+        _kappa.Set(kappa, i);
+    }
+
+    void Commit() override
+    {
+        _eps_p.data.swap(_eps_p_trial.data);
+        _kappa.data.swap(_kappa_trial.data);
+    }
+
+    Eigen::VectorXd Kappa() const
+    {
+        return _kappa.data;
+    }
+
+    Eigen::VectorXd EpsP() const
+    {
+        return _eps_p.data;
+    }
+
+    std::vector<std::pair<std::string, QValues*>> HistoryFields() override
+    {
+        return {{"kappa", &_kappa}, {"eps_p", &_eps_p}};
+    }
+
+    //! @brief histogram of the Newton iterations of the last Evaluate sweep,
+    //! bin i counts the IPs that converged after i iterations
+    std::map<std::string, Eigen::VectorXd> Stats() const override
+    {
+        Eigen::VectorXd histogram = Eigen::VectorXd::Zero(_max_iter + 1);
+        for (long i = 0; i < _newton_iterations.data.size(); ++i)
+            histogram[static_cast<int>(_newton_iterations.data[i])] += 1.;
+        return {{"newton_iterations", histogram}};
+    }
+
+private:
+    //! @return the number of Newton iterations (0 for an elastic step)
+    int ReturnMapping(const Eigen::VectorXd& eps, const Eigen::VectorXd& eps_p0, double kappa0, Eigen::VectorXd& sigma,
+                      Eigen::MatrixXd& Ct, Eigen::VectorXd& eps_p, double& kappa)
+    {
+        const Eigen::VectorXd sig_tr = _C * (eps - eps_p0);
+
+        double f, fk;
+        Eigen::VectorXd m;
+        Eigen::MatrixXd dm;
+        _yf.Evaluate(sig_tr, kappa0, f, m, dm, fk);
+
+        if (f <= 0.)
+        {
+            // elastic step
+            sigma = sig_tr;
+            Ct = _C;
+            eps_p = eps_p0;
+            kappa = kappa0;
+            return 0;
+        }
+
+        const int q = _q;
+        sigma = sig_tr;
+        kappa = kappa0;
+        double dl = 0.;
+
+        // residual [es; ek; ef] and its jacobian, unknowns [sigma; kappa; dl]
+        Eigen::VectorXd res(q + 2);
+        Eigen::MatrixXd jac(q + 2, q + 2);
+
+        auto fill_jacobian = [&]() {
+            Eigen::MatrixXd p, dp_dsig, dp_dk;
+            std::tie(p, dp_dsig, dp_dk) = _ri.Call(sigma, kappa);
+            if (dp_dsig.cols() != q)
+                dp_dsig = Eigen::MatrixXd::Zero(1, q);
+
+            jac.setZero();
+            jac.block(0, 0, q, q) = Eigen::MatrixXd::Identity(q, q) + dl * _C * dm;
+            jac.block(0, q + 1, q, 1) = _C * m;
+            jac.block(q, 0, 1, q) = -dl * dp_dsig;
+            jac(q, q) = 1. - dl * dp_dk(0, 0);
+            jac(q, q + 1) = -p(0, 0);
+            jac.block(q + 1, 0, 1, q) = m.transpose();
+            jac(q + 1, q) = fk;
+            return p(0, 0);
+        };
+
+        int iterations = _max_iter;
+        for (int iteration = 0; iteration < _max_iter; ++iteration)
+        {
+            const double p = fill_jacobian();
+
+            res.segment(0, q) = sigma - sig_tr + dl * _C * m;
+            res[q] = kappa - kappa0 - dl * p;
+            res[q + 1] = f;
+            if (res.norm() < _tol)
+            {
+                iterations = iteration;
+                break;
+            }
+
+            const Eigen::VectorXd dx = jac.lu().solve(res);
+            sigma -= dx.segment(0, q);
+            kappa -= dx[q];
+            dl -= dx[q + 1];
+
+            _yf.Evaluate(sigma, kappa, f, m, dm, fk);
+        }
+
+        // consistent tangent from the converged state
+        fill_jacobian();
+        const Eigen::MatrixXd jac_inv = jac.inverse();
+        Ct = jac_inv.block(0, 0, q, q) * _C;
+        eps_p = eps_p0 + dl * m;
+        return iterations;
+    }
+
+    const int _q;
+    const Eigen::MatrixXd _C;
+    const YieldVM _yf;
+    RateIndependentHistory _ri;
+    const double _tol;
+    const int _max_iter;
+
+    // history values, trial written in Evaluate, swapped in Commit
+    QValues _eps_p;
+    QValues _eps_p_trial;
+    QValues _kappa;
+    QValues _kappa_trial;
+    QValues _newton_iterations;
+};
+//! @brief Perzyna-type rate-dependent viscoplasticity with von Mises
+//! overstress
+//!
+//! The viscous consistency dl/dt = (f / y0)^N / eta replaces the yield
+//! residual of `MisesPlasticity` in the same coupled Newton scheme, with the
+//! time increment read from the DEL_T input slot (IpLoop::SetDeltaT). The
+//! rate-independent limit eta -> 0 recovers MisesPlasticity. EvaluateAll
+//! screens the trial state first, so only the yielded IPs of a block enter
+//! the Newton iteration.
+class PerzynaViscoplasticity : public LawInterface
+{
+public:
+    PerzynaViscoplasticity(double E, double nu, Constraint c, double sigma_y, double eta, double exponent = 1.,
+                           double H = 0., double tol = 1.e-9, int max_iter = 20)
+        : _q(Dim::Q(c))
+        , _C(C(E, nu, c))
+        , _yf(sigma_y, c, H)
+        , _y0(sigma_y)
+        , _eta(eta)
+        , _exponent(exponent)
+        , _tol(tol)
+        , _max_iter(max_iter)
+        , _eps_vp(_q)
+        , _eps_vp_trial(_q)
+        , _kappa(1)
+        , _kappa_trial(1)
+    {
+    }
+
+    void DefineOutputs(std::vector<QValues>& out) const override
+    {
+        out[SIGMA] = QValues(_q);
+        out[DSIGMA_DEPS] = QValues(_q, _q);
+    }
+
+    void DefineInputs(std::vector<QValues>& input) const override
+    {
+        input[EPS] = QValues(_q);
+        input[DEL_T] = QValues(1);
+    }
+
+    void Resize(int n) override
+    {
+        _eps_vp.Resize(n);
+        _eps_vp_trial.Resize(n);
+        _kappa.Resize(n);
+        _kappa_trial.Resize(n);
+    }
+
+    void Evaluate(const std::vector<QValues>& input, std::vector<QValues>& out, int i) override
+    {
+        Eigen::VectorXd sigma, eps_vp;
+        Eigen::MatrixXd Ct;
+        double kappa;
+        ReturnMapping(input[EPS].GetMap(i), input[DEL_T].GetScalar(i), _eps_vp.Get(i), _kappa.GetScalar(i), sigma, Ct,
+                      eps_vp, kappa);
+
+        out[SIGMA].Set(sigma, i);
+        out[DSIGMA_DEPS].Set(Ct, i);
+        _eps_vp_trial.Set(eps_vp, i);
+        _kappa_trial.Set(kappa, i);
+    }
+
+    void EvaluateAll(const std::vector<QValues>& input, std::vector<QValues>& out, const std::vector<int>& ips) override
+    {
+        // cheap trial screening pass: elastic IPs -- the bulk in impact runs
+        // outside the wave front -- are finished without entering the Newton
+        for (int ip : ips)
+        {
+            const Eigen::VectorXd sig_tr = _C * (input[EPS].GetMap(ip) - _eps_vp.GetMap(ip));
+            double f, fk;
+            Eigen::VectorXd m;
+            Eigen::MatrixXd dm;
+            _yf.Evaluate(sig_tr, _kappa.GetScalar(ip), f, m, dm, fk);
+            if (f <= 0.)
+            {
+                out[SIGMA].Set(sig_tr, ip);
+                out[DSIGMA_DEPS].Set(_C, ip);
+                _eps_vp_trial.Set(_eps_vp.Get(ip), ip);
+                _kappa_trial.Set(_kappa.GetScalar(ip), ip);
+            }
+            else
+            {
+                PerzynaViscoplasticity::Evaluate(input, out, ip);
+            }
+        }
+    }
+
+    void Update(const std::vector<QValues>& input, int i) override
+    {
+        Eigen::VectorXd sigma, eps_vp;
+        Eigen::MatrixXd Ct;
+        double kappa;
+        ReturnMapping(input[EPS].GetMap(i), input[DEL_T].GetScalar(i), _eps_vp.Get(i), _kappa.GetScalar(i), sigma, Ct,
+                      eps_vp, kappa);
+        _eps_vp.Set(eps_vp, i);
+        _kappa.Set(kappa, i);
+    }
+
+    void Commit() override
+    {
+        _eps_vp.data.swap(_eps_vp_trial.data);
+        _kappa.data.swap(_kappa_trial.data);
+    }
+
+    Eigen::VectorXd Kappa() const
+    {
+        return _kappa.data;
+    }
+
+    Eigen::VectorXd EpsVp() const
+    {
+        return _eps_vp.data;
+    }
+
+    std::vector<std::pair<std::string, QValues*>> HistoryFields() override
+    {
+        return {{"kappa", &_kappa}, {"eps_vp", &_eps_vp}};
+    }
+
+private:
+    //! @brief the Perzyna overstress resistance y0 (eta dl / dt)^(1/N) and
+    //! its dl-derivative; at f == R the viscous consistency holds
+    std::pair<double, double> Overstress(double dl, double del_t) const
+    {
+        const double rate = _eta * std::max(dl, 0.) / del_t;
+        const double inv_n = 1. / _exponent;
+        // clamp away from 0 where the derivative of rate^(1/N) is singular
+        const double rate_reg = std::max(rate, 1.e-12);
+        const double r = _y0 * std::pow(rate_reg, inv_n);
+        const double dr = _y0 * inv_n * std::pow(rate_reg, inv_n - 1.) * _eta / del_t;
+        return {dl <= 0. ? 0. : r, dr};
+    }
+
+    void ReturnMapping(const Eigen::VectorXd& eps, double del_t, const Eigen::VectorXd& eps_vp0, double kappa0,
+                       Eigen::VectorXd& sigma, Eigen::MatrixXd& Ct, Eigen::VectorXd& eps_vp, double& kappa)
+    {
+        const Eigen::VectorXd sig_tr = _C * (eps - eps_vp0);
+
+        double f, fk;
+        Eigen::VectorXd m;
+        Eigen::MatrixXd dm;
+        _yf.Evaluate(sig_tr, kappa0, f, m, dm, fk);
+
+        if (f <= 0.)
+        {
+            sigma = sig_tr;
+            Ct = _C;
+            eps_vp = eps_vp0;
+            kappa = kappa0;
+            return;
+        }
+        if (del_t <= 0.)
+            throw std::runtime_error("Viscoplastic overstress requires a positive DEL_T, see IpLoop::SetDeltaT!");
+
+        const int q = _q;
+        sigma = sig_tr;
+        kappa = kappa0;
+        double dl = 0.;
+
+        // residual [es; ek; ef] and its jacobian, unknowns [sigma; kappa; dl]
+        Eigen::VectorXd res(q + 2);
+        Eigen::MatrixXd jac(q + 2, q + 2);
+
+        auto fill_jacobian = [&]() {
+            jac.setZero();
+            jac.block(0, 0, q, q) = Eigen::MatrixXd::Identity(q, q) + dl * _C * dm;
+            jac.block(0, q + 1, q, 1) = _C * m;
+            jac(q, q) = 1.;
+            jac(q, q + 1) = -1.;
+            jac.block(q + 1, 0, 1, q) = m.transpose();
+            jac(q + 1, q) = fk;
+            jac(q + 1, q + 1) = -Overstress(dl, del_t).second;
+        };
+
+        for (int iteration = 0; iteration < _max_iter; ++iteration)
+        {
+            fill_jacobian();
+
+            res.segment(0, q) = sigma - sig_tr + dl * _C * m;
+            res[q] = kappa - kappa0 - dl;
+            res[q + 1] = f - Overstress(dl, del_t).first;
+            if (res.norm() < _tol)
+                break;
+
+            const Eigen::VectorXd dx = jac.lu().solve(res);
+            sigma -= dx.segment(0, q);
+            kappa -= dx[q];
+            dl -= dx[q + 1];
+
+            _yf.Evaluate(sigma, kappa, f, m, dm, fk);
+        }
+
+        // consistent tangent from the converged state
+        fill_jacobian();
+        const Eigen::MatrixXd jac_inv = jac.inverse();
+        Ct = jac_inv.block(0, 0, q, q) * _C;
+        eps_vp = eps_vp0 + dl * m;
+    }
+
+    const int _q;
+    const Eigen::MatrixXd _C;
+    const YieldVM _yf;
+    const double _y0;
+    const double _eta;
+    const double _exponent;
+    const double _tol;
+    const int _max_iter;
+
+    // history values, trial written in Evaluate, swapped in Commit
+    QValues _eps_vp;
+    QValues _eps_vp_trial;
+    QValues _kappa;
+    QValues _kappa_trial;
+};
@@ -0,0 +1,74 @@
+#pragma once
+#include "interfaces.h"
+
+//! @brief direct strain evaluation at the quadrature points
+//!
+//! Replaces the local projection of eps(d) onto the quadrature space -- a
+//! per-cell solve on every iteration -- by the explicit product of the
+//! reference B-matrices with the gathered cell displacements. Dofmap and
+//! B-matrices are extracted once at setup; `Compute` then fills
+//! `all_strains` for `IpLoop::Evaluate` in one batched pass over the cells.
+class StrainKernel
+{
+public:
+    //! @param dofmap n_cells x dofs_per_cell global indices into the
+    //!               displacement vector
+    //! @param b stacked B-matrices: the strain of IP `ip` of cell `cell` is
+    //!          the q x dofs_per_cell block starting at row
+    //!          (cell * ips_per_cell + ip) * q, applied to the cell
+    //!          displacements
+    //! @param q number of strain components per IP
+    StrainKernel(Eigen::MatrixXi dofmap, Eigen::MatrixXd b, int q)
+        : _dofmap(std::move(dofmap))
+        , _b(std::move(b))
+        , _q(q)
+    {
+        if (_b.cols() != _dofmap.cols())
+            throw std::runtime_error("The B-matrix columns don't match the dofs per cell!");
+        if (_dofmap.rows() == 0 or _b.rows() % (_q * _dofmap.rows()) != 0)
+            throw std::runtime_error("The B-matrix rows are no multiple of q times the number of cells!");
+        _ips_per_cell = _b.rows() / _q / _dofmap.rows();
+    }
+
+    int NumIps() const
+    {
+        return _dofmap.rows() * _ips_per_cell;
+    }
+
+    Eigen::VectorXd Compute(const Eigen::VectorXd& u, int threads = 1) const
+    {
+        Eigen::VectorXd all_strains(NumIps() * _q);
+        ComputeInto(u, all_strains, threads);
+        return all_strains;
+    }
+
+    //! @brief like `Compute`, but writes into caller-provided memory
+    void ComputeInto(Eigen::Ref<const Eigen::VectorXd> u, Eigen::Ref<Eigen::VectorXd> all_strains,
+                     int threads = 1) const
+    {
+        if (all_strains.size() != NumIps() * _q)
+            throw std::runtime_error("The strain buffer size does not match the number of IPs!");
+
+        const int n_cells = _dofmap.rows();
+        const int n_dofs = _dofmap.cols();
+        const int rows_per_cell = _ips_per_cell * _q;
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(threads) schedule(static) if (threads > 1)
+#endif
+        for (int cell = 0; cell < n_cells; ++cell)
+        {
+            Eigen::VectorXd u_cell(n_dofs);
+            for (int dof = 0; dof < n_dofs; ++dof)
+                u_cell[dof] = u[_dofmap(cell, dof)];
+
+            all_strains.segment(cell * rows_per_cell, rows_per_cell).noalias() =
+                    _b.middleRows(cell * rows_per_cell, rows_per_cell) * u_cell;
+        }
+    }
+
+private:
+    const Eigen::MatrixXi _dofmap;
+    const Eigen::MatrixXd _b;
+    const int _q;
+    int _ips_per_cell;
+};
@@ -0,0 +1,132 @@
+import unittest
+from constitutive.cpp import (
+    LocalDamage,
+    DamageLawExponential,
+    ModMisesEeq,
+    IpLoop,
+    Constraint,
+    Q,
+)
+import numpy as np
+
+N = 24  # IPs, partly damaging and partly elastic under the history below
+
+
+def make_law():
+    return LocalDamage(
+        20000.0,
+        0.2,
+        Constraint.PLANE_STRAIN,
+        DamageLawExponential(1.0e-4, 0.99, 100.0),
+        ModMisesEeq(10.0, 0.2, Constraint.PLANE_STRAIN),
+    )
+
+
+def strain_history():
+    np.random.seed(6174)
+    eps = 4.0e-4 * (np.random.random(3 * N) - 0.5)
+    return [eps, 1.5 * eps]
+
+
+def per_ip_matrices(tangent):
+    """per-IP 3x3 matrices of a flat DSIGMA_DEPS array (column-major per IP)"""
+    return tangent.reshape(N, 3, 3).transpose(0, 2, 1)
+
+
+class TestLoopModes(unittest.TestCase):
+    """
+    Every solver-facing loop mode is an implementation detail of the sweep:
+    each one must reproduce the stresses and the committed history of the
+    plain loop on the same strain history.
+    """
+
+    def setUp(self):
+        self.history = strain_history()
+        law, loop = make_law(), IpLoop()
+        loop.add_law(law)
+        loop.resize(N)
+        self.sigma_ref = []
+        self.tangent_ref = []
+        for eps in self.history:
+            loop.evaluate(eps)
+            self.sigma_ref.append(loop.get(Q.SIGMA).copy())
+            self.tangent_ref.append(loop.get(Q.DSIGMA_DEPS).copy())
+            loop.commit()
+        self.kappa_ref = law.kappa()
+
+    def run_mode(self, configure, evaluate_twice=False):
+        law, loop = make_law(), IpLoop()
+        loop.add_law(law)
+        configure(law, loop)
+        loop.resize(N)
+        sigmas = []
+        for eps in self.history:
+            loop.evaluate(eps)
+            if evaluate_twice:  # the second sweep is served from the cache
+                loop.evaluate(eps)
+            sigmas.append(loop.get(Q.SIGMA).copy())
+            loop.commit()
+        return law, loop, sigmas
+
+    def check(self, sigmas, kappa, rtol=1.0e-14):
+        for sigma, sigma_ref in zip(sigmas, self.sigma_ref):
+            np.testing.assert_allclose(sigma, sigma_ref, rtol=rtol, atol=rtol)
+        np.testing.assert_allclose(kappa, self.kappa_ref, rtol=rtol, atol=rtol)
+
+    def test_update_matches_commit(self):
+        law, loop = make_law(), IpLoop()
+        loop.add_law(law)
+        loop.resize(N)
+        for eps in self.history:
+            loop.update(eps)
+        np.testing.assert_array_equal(law.kappa(), self.kappa_ref)
+
+    def test_modes(self):
+        modes = {
+            "prescreen": lambda law, loop: law.set_prescreen(True),
+            "packed": lambda law, loop: loop.set_symmetric(Q.DSIGMA_DEPS),
+            "float32": lambda law, loop: loop.set_single_precision(Q.SIGMA),
+            "incremental": lambda law, loop: loop.set_incremental(1.0e-8),
+            "tiled": lambda law, loop: loop.set_block_size(7),
+        }
+        for name, configure in modes.items():
+            with self.subTest(mode=name):
+                law, loop, sigmas = self.run_mode(
+                    configure, evaluate_twice=name == "incremental"
+                )
+                self.check(
+                    sigmas, law.kappa(), rtol=1.0e-5 if name == "float32" else 1.0e-14
+                )
+
+    def test_packed_tangent_is_symmetrized(self):
+        # packing keeps the lower triangle, expansion mirrors it back
+        _, loop, _ = self.run_mode(
+            lambda law, loop: loop.set_symmetric(Q.DSIGMA_DEPS)
+        )
+        expanded = per_ip_matrices(loop.get(Q.DSIGMA_DEPS))
+        reference = per_ip_matrices(self.tangent_ref[-1])
+        lower = np.tril(reference)
+        mirrored = lower + np.transpose(np.tril(reference, -1), (0, 2, 1))
+        np.testing.assert_allclose(expanded, mirrored, rtol=1.0e-14, atol=1.0e-14)
+
+    def test_grouped(self):
+        # two interleaved laws: grouping sorts the storage by law into one
+        # contiguous slot range each, Get translates back to natural order
+        law_a, law_b, loop = make_law(), make_law(), IpLoop()
+        loop.add_law(law_a, list(range(0, N, 2)))
+        loop.add_law(law_b, list(range(1, N, 2)))
+        loop.set_grouped(True)
+        loop.resize(N)
+        sigmas = []
+        for eps in self.history:
+            loop.evaluate(eps)
+            sigmas.append(loop.get(Q.SIGMA).copy())
+            loop.commit()
+        for sigma, sigma_ref in zip(sigmas, self.sigma_ref):
+            np.testing.assert_array_equal(sigma, sigma_ref)
+        np.testing.assert_array_equal(law_a.kappa()[: N // 2], self.kappa_ref[0::2])
+        np.testing.assert_array_equal(law_b.kappa()[N // 2 :], self.kappa_ref[1::2])
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -0,0 +1,49 @@
+import unittest
+from constitutive.cpp import MisesPlasticity, IpLoop, Constraint, Q
+import numpy as np
+
+
+class TestMisesPlasticity(unittest.TestCase):
+    def setUp(self):
+        self.E, self.H, self.sigma_y = 1000.0, 100.0, 10.0
+        self.law = MisesPlasticity(
+            self.E, 0.0, Constraint.UNIAXIAL_STRAIN, self.sigma_y, self.H
+        )
+        self.loop = IpLoop()
+        self.loop.add_law(self.law)
+        self.loop.resize(1)
+
+    def test_elastic(self):
+        self.loop.evaluate([0.005])
+        self.assertAlmostEqual(self.loop.get(Q.SIGMA)[0], 5.0)
+        self.assertAlmostEqual(self.loop.get(Q.DSIGMA_DEPS)[0], self.E)
+
+    def test_radial_return(self):
+        # analytic 1D return mapping for trial stress 20:
+        #   dl = (20 - sigma_y) / (E + H), Ct = E H / (E + H)
+        self.loop.evaluate([0.02])
+        dl = (20.0 - self.sigma_y) / (self.E + self.H)
+        self.assertAlmostEqual(self.loop.get(Q.SIGMA)[0], 20.0 - self.E * dl)
+        self.assertAlmostEqual(
+            self.loop.get(Q.DSIGMA_DEPS)[0], self.E * self.H / (self.E + self.H)
+        )
+
+        # history is only committed explicitly
+        self.assertAlmostEqual(self.law.kappa()[0], 0.0)
+        self.loop.commit()
+        self.assertAlmostEqual(self.law.kappa()[0], dl)
+        self.assertAlmostEqual(self.law.eps_p()[0], dl)
+
+    def test_unloading_is_elastic(self):
+        self.loop.evaluate([0.02])
+        self.loop.commit()
+        sigma_p = self.loop.get(Q.SIGMA)[0]
+
+        d_eps = 0.001
+        self.loop.evaluate([0.02 - d_eps])
+        self.assertAlmostEqual(self.loop.get(Q.SIGMA)[0], sigma_p - self.E * d_eps)
+        self.assertAlmostEqual(self.loop.get(Q.DSIGMA_DEPS)[0], self.E)
+
+
+if __name__ == "__main__":
+    unittest.main()
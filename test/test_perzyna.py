@@ -0,0 +1,87 @@
+import unittest
+from constitutive.cpp import (
+    PerzynaViscoplasticity,
+    MisesPlasticity,
+    IpLoop,
+    Constraint,
+    Q,
+)
+import numpy as np
+
+
+class TestPerzynaViscoplasticity(unittest.TestCase):
+    def setUp(self):
+        self.E, self.H, self.sigma_y = 1000.0, 100.0, 10.0
+        self.del_t = 0.1
+
+    def loop(self, eta):
+        self.law = PerzynaViscoplasticity(
+            self.E, 0.0, Constraint.UNIAXIAL_STRAIN, self.sigma_y, eta, 1.0, self.H
+        )
+        loop = IpLoop()
+        loop.add_law(self.law)
+        loop.resize(1)
+        loop.set_del_t(self.del_t)
+        return loop
+
+    def test_elastic(self):
+        loop = self.loop(eta=5.0)
+        loop.evaluate([0.005])
+        self.assertAlmostEqual(loop.get(Q.SIGMA)[0], 5.0)
+        self.assertAlmostEqual(loop.get(Q.DSIGMA_DEPS)[0], self.E)
+
+    def test_rate_independent_limit(self):
+        # eta = 0 removes the overstress, so the step must match the
+        # MisesPlasticity radial return, here for trial stress 20:
+        #   dl = (20 - sigma_y) / (E + H), Ct = E H / (E + H)
+        loop = self.loop(eta=0.0)
+        loop.evaluate([0.02])
+        dl = (20.0 - self.sigma_y) / (self.E + self.H)
+        self.assertAlmostEqual(loop.get(Q.SIGMA)[0], 20.0 - self.E * dl)
+        self.assertAlmostEqual(
+            loop.get(Q.DSIGMA_DEPS)[0], self.E * self.H / (self.E + self.H)
+        )
+
+        mises = IpLoop()
+        mises.add_law(
+            MisesPlasticity(
+                self.E, 0.0, Constraint.UNIAXIAL_STRAIN, self.sigma_y, self.H
+            )
+        )
+        mises.resize(1)
+        mises.evaluate([0.02])
+        self.assertAlmostEqual(loop.get(Q.SIGMA)[0], mises.get(Q.SIGMA)[0])
+
+    def test_overstress(self):
+        # linear overstress (N = 1): f = sigma_y eta dl / del_t closes the
+        # system, so dl = (20 - sigma_y) / (E + H + sigma_y eta / del_t)
+        eta = 5.0
+        loop = self.loop(eta)
+        loop.evaluate([0.02])
+        dl = (20.0 - self.sigma_y) / (self.E + self.H + self.sigma_y * eta / self.del_t)
+        self.assertAlmostEqual(loop.get(Q.SIGMA)[0], 20.0 - self.E * dl)
+
+        # the viscous stress exceeds the rate-independent one
+        dl_ri = (20.0 - self.sigma_y) / (self.E + self.H)
+        self.assertGreater(loop.get(Q.SIGMA)[0], 20.0 - self.E * dl_ri)
+
+        # history is only committed explicitly
+        self.assertAlmostEqual(self.law.kappa()[0], 0.0)
+        loop.commit()
+        self.assertAlmostEqual(self.law.kappa()[0], dl)
+        self.assertAlmostEqual(self.law.eps_vp()[0], dl)
+
+    def test_missing_del_t_raises(self):
+        loop = IpLoop()
+        loop.add_law(
+            PerzynaViscoplasticity(
+                self.E, 0.0, Constraint.UNIAXIAL_STRAIN, self.sigma_y, 5.0
+            )
+        )
+        loop.resize(1)
+        with self.assertRaises(RuntimeError):
+            loop.evaluate([0.02])
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -0,0 +1,80 @@
+import unittest
+from constitutive.cpp import (
+    PlaneStressAdapter,
+    MisesPlasticity,
+    LinearElastic,
+    IpLoop,
+    Constraint,
+    Q,
+)
+import numpy as np
+
+
+def mises(sigma):
+    """von Mises stress of an in-plane (xx, yy, xy) state with sigma_zz = 0"""
+    sxx, syy, sxy = sigma
+    return np.sqrt(sxx**2 - sxx * syy + syy**2 + 3 * sxy**2)
+
+
+class TestPlaneStressAdapter(unittest.TestCase):
+    def setUp(self):
+        self.E, self.nu, self.H, self.sigma_y = 1000.0, 0.3, 100.0, 10.0
+        self.eps = [1.0e-3, -2.0e-4, 5.0e-4]
+
+    def adapter_loop(self, sigma_y):
+        self.mises_law = MisesPlasticity(
+            self.E, self.nu, Constraint.FULL, sigma_y, self.H
+        )
+        loop = IpLoop()
+        loop.add_law(PlaneStressAdapter(self.mises_law))
+        loop.resize(1)
+        return loop
+
+    def test_elastic_condensation(self):
+        # a never-yielding FULL law condensed to sigma_oop = 0 must reproduce
+        # the analytic plane-stress elasticity exactly
+        loop = self.adapter_loop(sigma_y=1.0e9)
+        loop.evaluate(self.eps)
+
+        reference = IpLoop()
+        reference.add_law(LinearElastic(self.E, self.nu, Constraint.PLANE_STRESS))
+        reference.resize(1)
+        reference.evaluate(self.eps)
+
+        np.testing.assert_array_almost_equal(
+            loop.get(Q.SIGMA), reference.get(Q.SIGMA)
+        )
+        np.testing.assert_array_almost_equal(
+            loop.get(Q.DSIGMA_DEPS), reference.get(Q.DSIGMA_DEPS)
+        )
+
+    def test_plastic_consistency(self):
+        # plastic step: the condensed stress must sit on the yield surface,
+        # sigma_eq = sigma_y + H kappa, with sigma_zz condensed to zero
+        loop = self.adapter_loop(sigma_y=self.sigma_y)
+        eps = 20 * np.array(self.eps)
+        loop.evaluate(eps)
+        loop.commit()
+        kappa = self.mises_law.kappa()[0]
+        self.assertGreater(kappa, 0.0)
+        self.assertAlmostEqual(
+            mises(loop.get(Q.SIGMA)), self.sigma_y + self.H * kappa, places=5
+        )
+
+        # the second step restarts the condensation from the committed
+        # out-of-plane strains and must stay consistent
+        loop.evaluate(1.5 * eps)
+        sigma = loop.get(Q.SIGMA).copy()
+        loop.commit()
+        kappa = self.mises_law.kappa()[0]
+        self.assertAlmostEqual(
+            mises(sigma), self.sigma_y + self.H * kappa, places=5
+        )
+
+        # re-evaluating the converged state reproduces it from the warm start
+        loop.evaluate(1.5 * eps)
+        np.testing.assert_array_almost_equal(loop.get(Q.SIGMA), sigma)
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -0,0 +1,139 @@
+import os
+import tempfile
+import unittest
+from constitutive.cpp import (
+    MisesPlasticity,
+    PerzynaViscoplasticity,
+    IpLoop,
+    OutputStreamer,
+    Constraint,
+    Q,
+)
+import numpy as np
+
+
+def mises_loop(n):
+    law = MisesPlasticity(1000.0, 0.0, Constraint.UNIAXIAL_STRAIN, 10.0, 100.0)
+    loop = IpLoop()
+    loop.add_law(law)
+    loop.resize(n)
+    return law, loop
+
+
+class TestSaveLoadState(unittest.TestCase):
+    def setUp(self):
+        self.tmp = tempfile.TemporaryDirectory()
+        self.path = os.path.join(self.tmp.name, "state.bin")
+
+        self.n = 5
+        self.law, self.loop = mises_loop(self.n)
+        self.eps = np.linspace(0.0, 0.05, self.n)
+        self.loop.evaluate(self.eps)
+        self.loop.commit()
+        self.loop.save_state(self.path)
+
+    def tearDown(self):
+        self.tmp.cleanup()
+
+    def test_round_trip(self):
+        law, loop = mises_loop(self.n)
+        loop.load_state(self.path)
+        np.testing.assert_array_equal(law.kappa(), self.law.kappa())
+        np.testing.assert_array_equal(law.eps_p(), self.law.eps_p())
+
+        # the restored loop continues exactly like the original
+        loop.evaluate(1.2 * self.eps)
+        self.loop.evaluate(1.2 * self.eps)
+        np.testing.assert_array_equal(loop.get(Q.SIGMA), self.loop.get(Q.SIGMA))
+
+    def test_size_mismatch(self):
+        _, loop = mises_loop(self.n + 1)
+        with self.assertRaises(RuntimeError):
+            loop.load_state(self.path)
+
+    def test_name_mismatch(self):
+        # same field count, but "eps_vp" instead of "eps_p"
+        loop = IpLoop()
+        loop.add_law(
+            PerzynaViscoplasticity(1000.0, 0.0, Constraint.UNIAXIAL_STRAIN, 10.0, 1.0)
+        )
+        loop.resize(self.n)
+        with self.assertRaises(RuntimeError):
+            loop.load_state(self.path)
+
+    def test_no_snapshot(self):
+        with open(self.path, "wb") as f:
+            f.write(b"not a snapshot at all")
+        _, loop = mises_loop(self.n)
+        with self.assertRaises(RuntimeError):
+            loop.load_state(self.path)
+
+
+class TestTransferFrom(unittest.TestCase):
+    def test_identity_coordinates(self):
+        # identical IP coordinates: every new IP's nearest donor is itself,
+        # so the transferred history must be bit-exact
+        n = 12
+        old_law, old_loop = mises_loop(n)
+        old_loop.evaluate(np.linspace(0.0, 0.05, n))
+        old_loop.commit()
+
+        coords = np.column_stack([np.arange(n) % 4, np.arange(n) // 4]).astype(float)
+        new_law, new_loop = mises_loop(n)
+        new_loop.transfer_from(old_loop, coords, coords)
+        np.testing.assert_array_equal(new_law.kappa(), old_law.kappa())
+        np.testing.assert_array_equal(new_law.eps_p(), old_law.eps_p())
+
+
+class TestOutputStreamer(unittest.TestCase):
+    def test_round_trip(self):
+        n = 4
+        law, loop = mises_loop(n)
+        eps = np.linspace(0.0, 0.03, n)
+
+        with tempfile.TemporaryDirectory() as tmp:
+            path = os.path.join(tmp, "frames.bin")
+            streamer = OutputStreamer(loop, path)
+            streamer.register(Q.SIGMA)
+            streamer.register_history("law0/kappa")
+
+            expected = []
+            for step in range(3):
+                loop.evaluate((step + 1) * eps)
+                loop.commit()
+                streamer.write_frame(time=0.1 * step)
+                expected.append((0.1 * step, loop.get(Q.SIGMA).copy(), law.kappa()))
+            streamer.flush()
+
+            names, frames = OutputStreamer.read_frames(path)
+            self.assertEqual(names, ["q%d" % int(Q.SIGMA), "law0/kappa"])
+            self.assertEqual(len(frames), 3)
+            for (time, fields), (time_x, sigma_x, kappa_x) in zip(frames, expected):
+                self.assertEqual(time, time_x)
+                np.testing.assert_array_equal(fields[0], sigma_x)
+                np.testing.assert_array_equal(fields[1], kappa_x)
+
+    def test_truncated_stream_raises(self):
+        n = 4
+        _, loop = mises_loop(n)
+
+        with tempfile.TemporaryDirectory() as tmp:
+            path = os.path.join(tmp, "frames.bin")
+            streamer = OutputStreamer(loop, path)
+            streamer.register(Q.SIGMA)
+            loop.evaluate(np.linspace(0.0, 0.03, n))
+            streamer.write_frame(time=0.0)
+            streamer.write_frame(time=1.0)
+            streamer.flush()
+
+            # a dying job cuts the file inside the second frame
+            with open(path, "rb") as f:
+                data = f.read()
+            with open(path, "wb") as f:
+                f.write(data[:-4])
+            with self.assertRaises(RuntimeError):
+                OutputStreamer.read_frames(path)
+
+
+if __name__ == "__main__":
+    unittest.main()